@@ -18,7 +18,7 @@ private:
   // used memory size
   size_t used;
 
-  // peak of `used` history value
+  // end of the highest block ever allocated, i.e. the size of the arena
   size_t peak;
 
   size_t alignment;
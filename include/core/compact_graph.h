@@ -0,0 +1,92 @@
+#pragma once
+#include "core/graph.h"
+#include <cstdint>
+
+namespace infini {
+
+/**
+ * @brief A read-only snapshot of a graph with integer handles. Operators and
+ * tensors are numbered by their position in GraphObj::getOperators() and
+ * GraphObj::getTensors(), and all adjacency lives in CSR arrays, so
+ * traversals touch contiguous memory instead of locking weak references.
+ *
+ * The snapshot does not follow later changes of the graph. getOperator() and
+ * getTensor() map handles back to the Ref based objects.
+ */
+class CompactGraph {
+public:
+  using Index = uint32_t;
+  static constexpr Index None = UINT32_MAX;
+
+  /**
+   * @brief A row of a CSR array.
+   */
+  class Row {
+    const Index *first;
+    const Index *last;
+
+  public:
+    Row(const Index *first, const Index *last) : first(first), last(last) {}
+    [[nodiscard]] const Index *begin() const { return first; }
+    [[nodiscard]] const Index *end() const { return last; }
+    [[nodiscard]] size_t size() const { return last - first; }
+    [[nodiscard]] bool empty() const { return first == last; }
+    Index operator[](size_t i) const { return first[i]; }
+  };
+
+private:
+  // Rows of `indices` in [offsets[i], offsets[i + 1]).
+  struct Csr {
+    vector<size_t> offsets{0};
+    vector<Index> indices;
+
+    [[nodiscard]] Row row(Index i) const {
+      return {indices.data() + offsets[i], indices.data() + offsets[i + 1]};
+    }
+    void endRow() { offsets.emplace_back(indices.size()); }
+  };
+
+  OpVec ops;
+  TensorVec tensors;
+  vector<OpType> opTypes;
+  vector<size_t> bytes;
+  vector<Index> sources;
+  // Per operator, in operand order.
+  Csr inputs;
+  Csr outputs;
+  // Per operator: distinct producers and consumers in ascending order.
+  Csr predecessors;
+  Csr successors;
+  // Per tensor: distinct consumers in ascending order.
+  Csr targets;
+
+public:
+  explicit CompactGraph(const GraphObj &graph);
+
+  [[nodiscard]] size_t numOperators() const { return ops.size(); }
+  [[nodiscard]] size_t numTensors() const { return tensors.size(); }
+
+  [[nodiscard]] OpType getOpType(Index op) const { return opTypes[op]; }
+  [[nodiscard]] Row getInputs(Index op) const { return inputs.row(op); }
+  [[nodiscard]] Row getOutputs(Index op) const { return outputs.row(op); }
+  [[nodiscard]] Row getPredecessors(Index op) const {
+    return predecessors.row(op);
+  }
+  [[nodiscard]] Row getSuccessors(Index op) const {
+    return successors.row(op);
+  }
+
+  [[nodiscard]] size_t getBytes(Index tensor) const { return bytes[tensor]; }
+  // The operator writing `tensor`, or None for a graph input.
+  [[nodiscard]] Index getSource(Index tensor) const { return sources[tensor]; }
+  [[nodiscard]] Row getTargets(Index tensor) const {
+    return targets.row(tensor);
+  }
+
+  [[nodiscard]] const Operator &getOperator(Index op) const { return ops[op]; }
+  [[nodiscard]] const Tensor &getTensor(Index tensor) const {
+    return tensors[tensor];
+  }
+};
+
+} // namespace infini
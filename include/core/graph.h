@@ -1,5 +1,6 @@
 #pragma once
 #include <algorithm>
+#include <unordered_map>
 
 #include "core/allocator.h"
 #include "core/operator.h"
@@ -7,54 +8,151 @@
 
 namespace infini {
 
+/**
+ * @brief What GraphObj::schedule() orders the operators for.
+ */
+enum class ScheduleObjective {
+  // The lowest peak of live tensor bytes, i.e. of the memory dataMalloc
+  // allocates.
+  PeakMemory,
+  // Consumers right after their producers, while the data is still in cache.
+  Locality,
+};
+
 class GraphObj : public Object {
 protected:
   Runtime runtime;
-  TensorVec tensors;
-  OpVec ops;
+  // Removed entries stay as null tombstones until the next compact(), so
+  // that removal is O(1). Iterate through getTensors() / getOperators().
+  mutable TensorVec tensors;
+  mutable OpVec ops;
+  // Slots of the entries above: tensors by FUID, operators by GUID.
+  mutable std::unordered_map<UidBaseType, size_t> tensorSlots;
+  mutable std::unordered_map<UidBaseType, size_t> opSlots;
+  mutable size_t deadTensors = 0;
+  mutable size_t deadOps = 0;
   Allocator allocator;
+  // Tensors marked by markOutput(), in marking order.
+  TensorVec outputs;
 
 public:
   explicit GraphObj(const Runtime &runtime)
       : runtime(runtime), allocator(runtime) {};
+  /**
+   * @brief Build a graph from clones of `ops_in` and the tensors they use.
+   * Cloned tensors keep their FUIDs but have no data.
+   */
+  GraphObj(const Runtime &runtime, const OpVec &ops_in);
   [[nodiscard]] string toString() const override;
   [[nodiscard]] Runtime getRuntime() const { return runtime; }
 
   Tensor addTensor(const Shape& dim, DataType dtype = DataType::Float32);
   Tensor addTensor(const Tensor &tensor);
   TensorVec addTensor(const TensorVec &tensors);
-  void removeOperator(const Operator &op) {
-    auto it = std::find(ops.begin(), ops.end(), op);
-    if (it != ops.end()) {
-      ops.erase(it);
-    }
-  }
+  /**
+   * @brief Remove `op` from the operator list in O(1). It is not
+   * disconnected from its tensors, see eraseOperator().
+   */
+  void removeOperator(const Operator &op);
+
+  /**
+   * @brief Disconnect `op` from its neighbours and remove it from the graph.
+   * Its output tensors stay in the graph without a source.
+   */
+  void eraseOperator(const Operator &op);
+
+  /**
+   * @brief Make `op` read `to` wherever it reads `from`, updating targets,
+   * predecessors and successors.
+   */
+  void replaceOpInput(const Operator &op, const Tensor &from, const Tensor &to);
+
+  /**
+   * @brief Make every consumer of `from` read `to` instead.
+   */
+  void replaceAllUses(const Tensor &from, const Tensor &to);
 
-  void removeTensor(const Tensor &tensor) {
-    auto it = std::find(tensors.begin(), tensors.end(), tensor);
-    if (it != tensors.end()) {
-      tensors.erase(it);
+  /**
+   * @brief Remove `tensor` from the tensor list in O(1).
+   */
+  void removeTensor(const Tensor &tensor);
+
+  /**
+   * @brief Remove `tensor` if no operator produces or consumes it any more.
+   */
+  void pruneTensor(const Tensor &tensor) {
+    if (!tensor->hasSource() && tensor->numTargets() == 0 &&
+        std::find(outputs.begin(), outputs.end(), tensor) == outputs.end()) {
+      removeTensor(tensor);
     }
   }
 
-  [[nodiscard]] const TensorVec &getTensors() const { return tensors; }
-  [[nodiscard]] const OpVec &getOperators() const { return ops; }
-  [[nodiscard]] Tensor getTensor(int) const;
+  [[nodiscard]] const TensorVec &getTensors() const {
+    compact();
+    return tensors;
+  }
+  [[nodiscard]] const OpVec &getOperators() const {
+    compact();
+    return ops;
+  }
+  /**
+   * @brief The tensor with FUID `fuid`, or nullptr. O(1).
+   */
+  [[nodiscard]] Tensor getTensor(UidBaseType fuid) const;
+  [[nodiscard]] bool hasTensor(const Tensor &tensor) const;
+  [[nodiscard]] bool hasOperator(const Operator &op) const;
 
   /**
    * @brief Sort the nodes in topological order.
    * It returns true if the sorting is successful.
    * Otherwise, false is returned, means that there are rings in the graph,
    * so the topological sorting fails.
+   * The order is kept up to date while operators are added or rewired, so
+   * this only sorts again after a change that breaks it.
    */
   bool topo_sort();
 
+  /**
+   * @brief Operators on a cycle of the graph, producers first, or an empty
+   * vector if the graph is acyclic.
+   */
+  [[nodiscard]] OpVec findCycle() const;
+
+  /**
+   * @brief The cycle from findCycle() as "Op[guid] -> Op[guid] -> ...".
+   */
+  [[nodiscard]] string cycleToString() const;
+
+  /**
+   * @brief Rewrite the graph to a fixed point with the patterns registered in
+   * RewriteRegistry. If no output is marked, the current outputs are marked
+   * first.
+   */
   void optimize();
 
   void shape_infer();
 
+  /**
+   * @brief Allocate the tensors in the current operator order. A tensor's
+   * buffer is reused after its last reader, unless it holds a graph input, a
+   * constant or a graph output, so only those keep their data after a run.
+   */
   void dataMalloc();
 
+  /**
+   * @brief Peak bytes of the tensors live at the same time when running the
+   * operators in their current topological order. dataMalloc needs at least
+   * this much, plus alignment and fragmentation.
+   */
+  [[nodiscard]] size_t getPeakLiveBytes() const;
+
+  /**
+   * @brief Reorder the operators for `objective` with a greedy list
+   * scheduler and return getPeakLiveBytes() of the new order. Call it before
+   * dataMalloc.
+   */
+  size_t schedule(ScheduleObjective objective = ScheduleObjective::PeakMemory);
+
   /**
    * @brief Add an operator and create its outputs. Output tensor arguments
    * should be empty Refs (e.g., nullptr).
@@ -65,6 +163,17 @@ public:
     return op;
   }
 
+  /**
+   * @brief Add a copy of `op` with the same attributes that reads `inputs`
+   * and writes `outputs`.
+   */
+  Operator addOpClone(const Operator &op, const TensorVec &inputs,
+                      const TensorVec &outputs) {
+    auto clone = op->clone(inputs, outputs);
+    addOperatorAndConnect(clone);
+    return clone;
+  }
+
   /**
    * @brief Add an operator with its outputs specified.
    */
@@ -80,8 +189,8 @@ public:
    */
   [[nodiscard]] TensorVec getInputs() const {
     TensorVec ret;
-    for (const auto &t : tensors) {
-      if (!t->getSource()) {
+    for (const auto &t : getTensors()) {
+      if (!t->hasSource()) {
         ret.emplace_back(t);
       }
     }
@@ -89,12 +198,33 @@ public:
   }
 
   /**
-   * @brief Gets output tensors of this graph.
+   * @brief Mark `tensor` as an output of this graph. Once any tensor is
+   * marked, only the marked tensors are outputs and everything they do not
+   * depend on is dead code.
+   */
+  void markOutput(const Tensor &tensor);
+
+  /**
+   * @brief If `tensor` is an output of this graph: a marked tensor, or any
+   * tensor without targets when no tensor is marked.
+   */
+  [[nodiscard]] bool isOutput(const Tensor &tensor) const {
+    if (outputs.empty()) {
+      return tensor->numTargets() == 0;
+    }
+    return std::find(outputs.begin(), outputs.end(), tensor) != outputs.end();
+  }
+
+  /**
+   * @brief Gets output tensors of this graph, see isOutput().
    */
   [[nodiscard]] TensorVec getOutputs() const {
+    if (!outputs.empty()) {
+      return outputs;
+    }
     TensorVec ret;
-    for (const auto &t : tensors) {
-      if (t->getTargets().empty()) {
+    for (const auto &t : getTensors()) {
+      if (t->numTargets() == 0) {
         ret.emplace_back(t);
       }
     }
@@ -110,9 +240,31 @@ private:
   void addOperatorAndConnect(const Operator &op);
 
   /**
-   * @brief If the nodes is sorted in topological order.
+   * @brief Add a connected `op` to `ops` in O(degree), in a slot that keeps
+   * the order topological if there is one and otherwise marking it unsorted.
+   */
+  void placeOperator(const Operator &op);
+
+  /**
+   * @brief Drop the tombstones of removed tensors and operators.
+   */
+  void compact() const;
+
+  /**
+   * @brief Refresh opSlots after `ops` changed.
+   */
+  void reindexOperators() const;
+
+  /**
+   * @brief Kahn's algorithm in O(V + E). Operators on or behind a cycle are
+   * left out of the result.
+   */
+  [[nodiscard]] OpVec kahnSort() const;
+
+  /**
+   * @brief If the nodes is sorted in topological order. An empty graph is.
    */
-  bool sorted{};
+  bool sorted{true};
 };
 
 } // namespace infini
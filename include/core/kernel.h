@@ -16,6 +16,12 @@ public:
    * @brief Executes an op with a default parameter.
    */
   virtual void compute(const Operator &op, const RuntimeObj *context) const = 0;
+
+  /**
+   * @brief Called once the tensors of `op` are allocated and its constants
+   * loaded, ahead of the first compute(), e.g. to pack constant weights.
+   */
+  virtual void prepare(const Operator &op, const RuntimeObj *context) const {}
 };
 
 class KernelRegistry {
@@ -49,6 +55,9 @@ public:
                                        get_kernel_attrs_str(kernelAttrs) + "}");
     return std::get<0>(it->second);
   }
+  [[nodiscard]] bool hasKernel(const KernelAttrs &kernelAttrs) const {
+    return kernels.find(kernelAttrs) != kernels.end();
+  }
   [[nodiscard]] const KernelRecord &
   getKernelItem(const KernelAttrs &kernelAttrs) const {
     return kernels.at(kernelAttrs);
@@ -1,11 +1,34 @@
 #pragma once
 #include "core/common.h"
 #include "ref.h"
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 
 namespace infini {
 
-using UidBaseType = int;
+using UidBaseType = int64_t;
+
+/**
+ * @brief Hands out unique IDs to any number of threads. Each thread reserves
+ * a block of IDs with one atomic add and then counts through it locally, so
+ * generating an ID almost never touches shared memory. IDs are unique but
+ * only increase within a thread.
+ */
+template <typename Tag> class UidGenerator {
+  static constexpr UidBaseType blockSize = 1024;
+  inline static std::atomic<UidBaseType> nextBlock{1};
+
+public:
+  static UidBaseType generate() {
+    thread_local UidBaseType next = 0, end = 0;
+    if (next == end) {
+      next = nextBlock.fetch_add(blockSize, std::memory_order_relaxed);
+      end = next + blockSize;
+    }
+    return next++;
+  }
+};
 
 class Uid {
 protected:
@@ -27,10 +50,7 @@ public:
 
 class Guid : public Uid {
 private:
-  static UidBaseType generateGuid() {
-    static UidBaseType guidCnt = 0;
-    return ++guidCnt;
-  }
+  static UidBaseType generateGuid() { return UidGenerator<Guid>::generate(); }
 
 public:
   Guid() : Uid(generateGuid()) {}
@@ -49,10 +69,7 @@ public:
  */
 class Fuid : public Uid {
 private:
-  static UidBaseType generateFuid() {
-    static UidBaseType fuidCnt = 0;
-    return ++fuidCnt;
-  }
+  static UidBaseType generateFuid() { return UidGenerator<Fuid>::generate(); }
 
 public:
   Fuid() : Uid(generateFuid()) {}
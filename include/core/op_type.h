@@ -20,6 +20,15 @@ struct OpType {
     Relu,
     Sub,
     Transpose,
+    FusedElementWise,
+    Reshape,
+    Flatten,
+    Squeeze,
+    Unsqueeze,
+    Slice,
+    Split,
+    QuantizeLinear,
+    DequantizeLinear,
 
   } type;
 
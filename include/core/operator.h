@@ -35,12 +35,14 @@ public:
   // getter and setter
   [[nodiscard]] const TensorVec &getInputs() const { return inputs; }
   [[nodiscard]] const TensorVec &getOutputs() const { return outputs; }
-  [[nodiscard]] Tensor getInputs(size_t i) const { return inputs.at(i); }
-  [[nodiscard]] Tensor getOutput() const {
+  [[nodiscard]] const Tensor &getInputs(size_t i) const {
+    return inputs.at(i);
+  }
+  [[nodiscard]] const Tensor &getOutput() const {
     IT_ASSERT(outputs.size() == 1, "Unimplemented");
     return outputs[0];
   }
-  [[nodiscard]] Tensor getOutput(size_t i) const {
+  [[nodiscard]] const Tensor &getOutput(size_t i) const {
     IT_ASSERT(i < outputs.size(), "Index exceeded");
     return outputs.at(i);
   }
@@ -56,6 +58,48 @@ public:
   [[nodiscard]] DataType getOutDType() const { return getOutput()->getDType(); }
   [[nodiscard]] virtual int numInputs() const = 0;
   [[nodiscard]] virtual int numOutputs() const = 0;
+  /**
+   * @brief The OpType followed by the attributes of the operator. Operators
+   * with equal attribute vectors compute the same outputs from the same
+   * inputs.
+   */
+  [[nodiscard]] virtual vector<int> getOpAttrVector() const {
+    return {type.underlying()};
+  }
+  /**
+   * @brief Index of an input the output can be computed in place of, i.e.
+   * written into the buffer of. GraphObj::dataMalloc decides if it is.
+   */
+  [[nodiscard]] virtual optional<int> getInplaceInput() const {
+    return std::nullopt;
+  }
+  /**
+   * @brief Index of an input the outputs can be views of, i.e. read from
+   * the buffer of through other strides without copying. GraphObj::dataMalloc
+   * takes the view of an output if it is contiguous, or else if it is no
+   * graph output and every consumer supportsStridedInputs().
+   */
+  [[nodiscard]] virtual optional<int> getViewInput() const {
+    return std::nullopt;
+  }
+  /**
+   * @brief Strides and element offset of output `i` as a view of input
+   * getViewInput(), given the current layout of that input.
+   */
+  [[nodiscard]] virtual std::pair<Strides, size_t> inferView(size_t i) const {
+    IT_TODO_HALT();
+    return {};
+  }
+  /**
+   * @brief If the kernel reads inputs through their strides, so that they
+   * may be views. Inputs are contiguous otherwise.
+   */
+  [[nodiscard]] virtual bool supportsStridedInputs() const { return false; }
+  /**
+   * @brief If the views of a contiguous input are contiguous, as for a
+   * reshape. Such views are always taken.
+   */
+  [[nodiscard]] virtual bool preservesContiguity() const { return false; }
 
   /**
    * @brief Clone this operator and replace its inputs and outputs.
@@ -0,0 +1,63 @@
+#pragma once
+#include "core/graph.h"
+#include <functional>
+
+namespace infini {
+
+struct PipelineConfig {
+  // Number of contiguous slices of the topologically sorted operator list.
+  // Each stage runs on its own thread.
+  size_t nStages = 2;
+  // Number of buffer sets, i.e. micro-batches in flight. 0 means one per
+  // stage; 2 with two stages is classic double buffering.
+  size_t nBuffers = 0;
+  // OpenMP threads used by the kernels of each stage. 0 keeps the default.
+  int threadsPerStage = 0;
+};
+
+/**
+ * @brief Streams micro-batches through a graph with different stages of the
+ * graph working on different micro-batches at the same time.
+ *
+ * Every buffer set is a clone of the graph with its own tensors, so a stage
+ * never shares buffers with another micro-batch. Graph inputs that hold data
+ * when the executor is built (e.g. weights) are copied into every clone.
+ */
+class PipelineExecutor {
+public:
+  // Fills the graph inputs of a buffer set for micro-batch `index`. `inputs`
+  // follows the order of `GraphObj::getInputs()` of the original graph.
+  using Feeder = std::function<void(size_t index, const TensorVec &inputs)>;
+  // Reads the graph outputs of micro-batch `index`. `outputs` follows the
+  // order of `GraphObj::getOutputs()` of the original graph.
+  using Consumer = std::function<void(size_t index, const TensorVec &outputs)>;
+
+private:
+  Runtime runtime;
+  PipelineConfig config;
+  // Operator ranges [stageBegin[s], stageBegin[s + 1]) of the sorted list.
+  vector<size_t> stageBegin;
+  vector<Graph> buffers;
+  // stageOps[slot][stage] are the operators of a stage in one buffer set.
+  vector<vector<OpVec>> stageOps;
+  vector<TensorVec> bufferInputs;
+  vector<TensorVec> bufferOutputs;
+
+public:
+  PipelineExecutor(const Graph &graph, PipelineConfig config = {});
+
+  /**
+   * @brief Pushes `nBatches` micro-batches through the pipeline and returns
+   * when all of them were consumed. Rethrows the first exception raised by a
+   * feeder, a kernel or a consumer.
+   */
+  void run(size_t nBatches, const Feeder &feed, const Consumer &consume);
+
+  [[nodiscard]] size_t numStages() const { return stageBegin.size() - 1; }
+  [[nodiscard]] OpVec getStage(size_t stage) const;
+
+private:
+  void partition(const OpVec &ops);
+};
+
+} // namespace infini
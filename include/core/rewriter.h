@@ -0,0 +1,93 @@
+#pragma once
+#include "core/graph.h"
+#include <functional>
+
+namespace infini {
+
+/**
+ * @brief A local graph rewrite. The matcher looks for chains of operators
+ * whose types follow `chain`, where `ops[i + 1]` consumes an output of
+ * `ops[i]`, and hands each match to `rewrite`.
+ *
+ * Priorities used by the built-in passes, highest first:
+ *   500 dead code elimination
+ *   400 constant folding
+ *   350 common subexpression elimination
+ *   300 layout canonicalization (transpose and cast chains, split / concat
+ *       pairs)
+ *   250 transpose sinking / hoisting, moving casts across layout operators
+ *   200 folding layout into operators (transpose into matmul)
+ *   175 rewriting matmuls of dequantized Int8 values into Int8 matmuls
+ *   170 folding the dequantized constants left after that
+ *   150 merging matmuls that share an input
+ *   100 epilogue folding into matmul
+ *    50 element-wise fusion
+ */
+struct RewritePattern {
+  string name;
+  // Patterns of a higher priority reach a fixed point before lower ones run,
+  // and are re-run whenever a lower priority pattern changes the graph.
+  int priority = 0;
+  // OpTypes of the producer -> consumer chain; OpType::Unknown matches any
+  // operator.
+  vector<OpType> chain;
+  // Require every intermediate output of the chain to have one consumer and
+  // not to be a graph output.
+  bool singleUse = true;
+  // Applies the rewrite through the mutation API of GraphObj and returns
+  // true if the graph changed. Returning false rejects the match.
+  std::function<bool(GraphObj &, const OpVec &)> rewrite;
+};
+
+/**
+ * @brief Drives a set of patterns over a graph with a worklist until no
+ * pattern applies any more.
+ */
+class PatternRewriter {
+  // Sorted by descending priority.
+  vector<RewritePattern> patterns;
+  size_t maxRewrites;
+
+public:
+  explicit PatternRewriter(vector<RewritePattern> patterns = {},
+                           size_t maxRewrites = 1 << 20);
+
+  void add(RewritePattern pattern);
+
+  /**
+   * @brief Rewrite the graph to a fixed point. Returns the number of
+   * rewrites applied.
+   */
+  size_t run(GraphObj &graph) const;
+
+private:
+  // Runs the patterns in [begin, end) to a fixed point.
+  size_t runLevel(GraphObj &graph, size_t begin, size_t end,
+                  size_t budget) const;
+  bool match(const GraphObj &graph, const RewritePattern &pattern, OpVec &ops,
+             const std::function<bool(const OpVec &)> &onMatch) const;
+};
+
+class RewriteRegistry {
+  vector<RewritePattern> patterns;
+
+public:
+  static RewriteRegistry &getInstance() {
+    static RewriteRegistry instance;
+    return instance;
+  }
+  bool registerPattern(RewritePattern pattern);
+  [[nodiscard]] const vector<RewritePattern> &getPatterns() const {
+    return patterns;
+  }
+};
+
+} // namespace infini
+
+#define _REGISTER_REWRITE_1(cnt, ...)                                          \
+  namespace infini {                                                           \
+  static const bool _CAT(_register_rewrite_, cnt) =                            \
+      RewriteRegistry::getInstance().registerPattern(__VA_ARGS__);             \
+  }
+
+#define REGISTER_REWRITE(...) _REGISTER_REWRITE_1(__COUNTER__, __VA_ARGS__)
@@ -1,6 +1,12 @@
 #pragma once
 #include "core/common.h"
 #include "core/ref.h"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
 
 namespace infini {
 
@@ -9,6 +15,7 @@ class OperatorObj;
 class GraphObj;
 class RuntimeObj;
 class BlobObj;
+class ThreadPool;
 
 using Tensor = Ref<TensorObj>;
 using Operator = Ref<OperatorObj>;
@@ -21,27 +28,102 @@ using OpVec = vector<Operator>;
 
 enum class Device : uint8_t { CPU = 1 };
 
+/**
+ * @brief Cooperative cancellation flag shared between the caller and a run.
+ * The runtime observes it between operators, never inside a kernel.
+ */
+class CancelToken {
+  std::atomic<bool> cancelled{false};
+
+public:
+  void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+  [[nodiscard]] bool isCancelled() const {
+    return cancelled.load(std::memory_order_relaxed);
+  }
+};
+
+using CancelHandle = Ref<CancelToken>;
+
+struct RunOptions {
+  // Stops the run before the next operator once cancelled.
+  CancelHandle cancel;
+  // Stops the run before the next operator once this point is passed.
+  optional<std::chrono::steady_clock::time_point> deadline;
+};
+
+// Invoked on a worker thread when an asynchronous run finishes. The argument
+// is null on success, otherwise it holds the exception that stopped the run.
+using RunCallback = std::function<void(std::exception_ptr)>;
+
 class RuntimeObj : public std::enable_shared_from_this<RuntimeObj> {
 protected:
   Device device;
 
+private:
+  // Worker pool backing `runAsync`, created on first use.
+  mutable Ref<ThreadPool> workers;
+  mutable std::mutex workersMutex;
+  size_t nWorkers = 0;
+
 public:
   explicit RuntimeObj(Device device) : device(device) {}
   RuntimeObj(RuntimeObj &other) = delete;
   RuntimeObj &operator=(RuntimeObj const &) = delete;
 
-  RuntimeObj(RuntimeObj &&other) = default;
-  RuntimeObj &operator=(RuntimeObj &&) = default;
-
   virtual ~RuntimeObj() = default;
 
-  virtual void run(const Graph &graph) const = 0;
+  void run(const Graph &graph) const { run(graph, RunOptions{}); }
+  /**
+   * @brief Executes the graph, checking `options` between operators. Throws
+   * `Exception` when the run is cancelled or misses its deadline.
+   */
+  virtual void run(const Graph &graph, const RunOptions &options) const = 0;
+  /**
+   * @brief Executes a single operator whose tensors are already allocated.
+   */
+  virtual void runOp(const Operator &op) const = 0;
+  /**
+   * @brief Lets the kernel of `op` prepare for its runs, see
+   * Kernel::prepare. Operators without a kernel are skipped.
+   */
+  virtual void prepareOp(const Operator &op) const = 0;
+
+  /**
+   * @brief Executes the graph on the runtime's worker pool.
+   *
+   * The returned future becomes ready after `callback` (if any) has returned,
+   * and rethrows the exception that stopped the run. A graph owns a single
+   * set of tensor buffers, so runs of the same graph must not overlap; runs
+   * of different graphs may.
+   */
+  std::future<void> runAsync(const Graph &graph, RunOptions options = {},
+                             RunCallback callback = nullptr) const;
+
+  /**
+   * @brief Sets the size of the worker pool; 0 means one worker per hardware
+   * thread. An existing pool is replaced after the runs queued on it have
+   * finished, so this must not be called from a run callback.
+   */
+  void setWorkerThreads(size_t n);
+
   virtual void *alloc(size_t size) = 0;
   virtual void dealloc(void *ptr) = 0;
 
   static bool isCpu() { return true; }
 
   virtual string toString() const = 0;
+
+protected:
+  /**
+   * @brief Throws if the run described by `options` should stop now.
+   */
+  static void checkRunOptions(const RunOptions &options);
+
+private:
+  /**
+   * @brief Queues `task` on the worker pool, creating the pool on first use.
+   */
+  void submitToWorkers(std::function<void()> task) const;
 };
 
 class NativeCpuRuntimeObj : public RuntimeObj {
@@ -53,7 +135,10 @@ public:
     return instance;
   }
   void dealloc(void *ptr) override;
-  void run(const Graph &graph) const override;
+  using RuntimeObj::run;
+  void run(const Graph &graph, const RunOptions &options) const override;
+  void runOp(const Operator &op) const override;
+  void prepareOp(const Operator &op) const override;
   void *alloc(size_t size) override;
   string toString() const override;
 };
@@ -3,6 +3,7 @@
 #include "core/data_type.h"
 #include "core/object.h"
 #include "core/runtime.h"
+#include "utils/small_vector.h"
 #include <cmath>
 #include <cstddef>
 #include <cstring>
@@ -11,7 +12,10 @@ namespace infini {
 
 class GraphObj;
 using ShapeElem = int;
-using Shape = vector<ShapeElem>;
+// Ranks up to 6 are stored inline.
+using Shape = SmallVector<ShapeElem, 6>;
+// Element strides. 64-bit, as their products exceed the range of ShapeElem.
+using Strides = SmallVector<int64_t, 6>;
 class TensorObj : public Object {
   friend class GraphObj;
 
@@ -23,10 +27,19 @@ protected:
   WRef<OperatorObj> source;
   Blob data;
   Runtime runtime;
+  // Host copy of the values of a constant, shared with clones.
+  Ref<vector<uint8_t>> constant;
 
 private:
   Shape shape;
   size_t _size; // Cache of Π(shape).
+  // Layout in the blob: element strides, and the element offset of the
+  // first element. Contiguous unless the tensor is a view.
+  Strides strides;
+  size_t offset = 0;
+  // Stamped from a global counter whenever the data is rewritten, so that
+  // caches derived from the data can tell whether they are stale.
+  uint64_t dataVersion = 0;
   Fuid fuid;    // Cloned tensors share the same id. Tensors constructed from
                 // scratch have a new id.
 
@@ -35,18 +48,76 @@ public:
   ~TensorObj() override = default;
   [[nodiscard]] string toString() const override;
 
+  /**
+   * @brief Clone the tensor without its data and connections. The clone
+   * shares the FUID of this tensor.
+   */
+  [[nodiscard]] Tensor clone() const {
+    auto obj = make_ref<TensorObj>(*this);
+    obj->data = nullptr;
+    obj->targets.clear();
+    obj->source.reset();
+    return obj;
+  }
+
   [[nodiscard]] size_t size() const { return _size; }
   [[nodiscard]] size_t getBytes() const { return _size * dtype.getSize(); }
 
-  [[nodiscard]] Shape getDims() const { return shape; }
+  [[nodiscard]] const Shape &getDims() const { return shape; }
   void setShape(Shape shape_);
+  [[nodiscard]] const Strides &getStrides() const { return strides; }
+  [[nodiscard]] size_t getOffset() const { return offset; }
+  /**
+   * @brief If the elements are laid out in row-major order without gaps,
+   * from getRawDataPtr() on. Only views (see OperatorObj::getViewInput) may
+   * not be.
+   */
+  [[nodiscard]] bool isContiguous() const;
+  /**
+   * @brief Lay the tensor out as a view into its blob.
+   */
+  void setView(Strides strides_, size_t offset_);
+  /**
+   * @brief Lay the tensor out contiguously from the start of its blob.
+   */
+  void resetView();
+  /**
+   * @brief Row-major strides of a contiguous tensor of shape `shape`.
+   */
+  static Strides contiguousStrides(const Shape &shape);
   [[nodiscard]] size_t getRank() const { return shape.size(); }
   [[nodiscard]] UidBaseType getFuid() const { return fuid; }
 
-  void
-  setData(std::function<void(void *, size_t, DataType)> const &generator) const;
+  void setData(std::function<void(void *, size_t, DataType)> const &generator);
 
   void setDataBlob(const Blob &blob);
+  [[nodiscard]] Blob getDataBlob() const { return data; }
+  /**
+   * @brief Changes whenever the data is rewritten by setData(),
+   * setDataBlob() or loadConstant(). Unique across tensors, clones included.
+   * Writes through getRawDataPtr() are not seen; call touchData() after them.
+   */
+  [[nodiscard]] uint64_t getDataVersion() const { return dataVersion; }
+  void touchData();
+  [[nodiscard]] bool hasData() const { return data != nullptr; }
+
+  /**
+   * @brief Mark the tensor as a constant with the values of `generator`
+   * (zeros if it is empty). The values are known before the graph allocates
+   * memory, so optimizations can fold them; GraphObj::dataMalloc copies them
+   * into the tensor's blob.
+   */
+  void setConstant(
+      std::function<void(void *, size_t, DataType)> const &generator = nullptr);
+  [[nodiscard]] bool isConstant() const { return constant != nullptr; }
+  /**
+   * @brief A blob over the host copy of a constant's values.
+   */
+  [[nodiscard]] Blob getConstantBlob() const;
+  /**
+   * @brief Copy the values of a constant into its blob.
+   */
+  void loadConstant();
 
   void printData() const;
   [[nodiscard]] bool equalData(const Tensor &rhs,
@@ -58,18 +129,27 @@ public:
     return equalDataImpl(getRawDataPtr<T *>(), dataVector.data(), size());
   }
 
+  /**
+   * @brief Pointer to the first element, i.e. getOffset() elements into the
+   * blob. Index it with getStrides() unless the tensor is contiguous.
+   */
   template <typename T> T getRawDataPtr() const {
     static_assert(std::is_pointer_v<T>,
                   "Raw data pointer has a type of pointer");
     IT_ASSERT(data != nullptr);
-    return data->getPtr<T>();
+    auto *ptr = data->getPtr<uint8_t *>() + offset * dtype.getSize();
+    return static_cast<T>(static_cast<void *>(ptr));
   }
 
   [[nodiscard]] DataType getDType() const { return dtype; }
   [[nodiscard]] Runtime getRuntime() const { return runtime; }
 
   [[nodiscard]] OpVec getTargets() const { return wrefs_to_refs(targets); }
+  // getTargets().size() without building the vector.
+  [[nodiscard]] size_t numTargets() const { return targets.size(); }
   [[nodiscard]] Operator getSource() const { return source.lock(); }
+  // If an operator writes this tensor, without locking it.
+  [[nodiscard]] bool hasSource() const { return !source.expired(); }
 
 private:
   template <class T> [[nodiscard]] string dataToString() const {
@@ -77,8 +157,8 @@ private:
     builder << "Tensor: " << guid << '\n';
 
     auto numDims = shape.size();
-    auto dimSzVec = vector<int>(numDims, 1);
-    auto ptr = data->getPtr<T *>();
+    auto dimSzVec = vector<size_t>(numDims, 1);
+    auto ptr = getRawDataPtr<T *>();
     dimSzVec[numDims - 1] = shape[numDims - 1];
 
     for (size_t i = numDims - 1; i != 0; --i) {
@@ -94,7 +174,7 @@ private:
 
       builder << ptr[i];
       for (size_t j = 0; j < numDims; ++j) {
-        if ((int)i % dimSzVec[j] == dimSzVec[j] - 1) {
+        if (i % dimSzVec[j] == dimSzVec[j] - 1) {
           builder << "]";
         }
       }
@@ -103,7 +183,7 @@ private:
         builder << ", ";
       }
 
-      auto column = (size_t)dimSzVec[numDims - 1];
+      auto column = dimSzVec[numDims - 1];
       if (i % column == column - 1) {
         builder << '\n';
       }
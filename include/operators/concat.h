@@ -31,6 +31,8 @@ public:
     return static_cast<int>(inputs.size());
   }
   [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
   [[nodiscard]] int getDim() const { return dim; }
 };
 
@@ -27,6 +27,7 @@ public:
   std::string toString() const override;
   int numInputs() const override { return 2; }
   int numOutputs() const override { return 1; }
+  bool supportsStridedInputs() const override { return true; }
 };
 
 #define DEFINE_ELEMENT_WISE_OBJ(prefix, type)                                  \
@@ -0,0 +1,59 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini {
+
+/**
+ * @brief One step of a fused element-wise chain. Binary steps combine the
+ * running value with input `operand`; unary steps only use the running value.
+ */
+struct FusedStep {
+  OpType type;
+  // Index of the second operand of a binary step, -1 for unary steps.
+  int operand = -1;
+  // Computes `operand op value` instead of `value op operand`.
+  bool operandFirst = false;
+  // Bounds of a Clip step.
+  optional<float> min, max;
+};
+
+/**
+ * @brief A chain of element-wise operators (Add, Sub, Mul, Div, Relu, Clip)
+ * evaluated in a single pass over the output. The running value starts as
+ * `inputs[0]` and every step updates it. Inputs are broadcast to the output
+ * shape.
+ *
+ */
+class FusedElementWiseObj : public OperatorObj {
+  vector<FusedStep> steps;
+
+public:
+  /**
+   * @brief Construct a new FusedElementWise object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param inputs The start value followed by the operands of binary steps.
+   * @param output The output tensor.
+   * @param steps The operators of the chain, in evaluation order.
+   */
+  FusedElementWiseObj(GraphObj *graph, const TensorVec &inputs, Tensor output,
+                      vector<FusedStep> steps);
+  OP_CLONE(FusedElementWiseObj);
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override {
+    return static_cast<int>(inputs.size());
+  }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] const vector<FusedStep> &getSteps() const { return steps; }
+
+  /**
+   * @brief If `type` can be a step of a fused chain.
+   */
+  static bool isFusible(OpType type);
+};
+
+} // namespace infini
@@ -3,6 +3,45 @@
 
 namespace infini {
 
+/**
+ * @brief Element-wise work folded into a Matmul and applied to each output
+ * tile right after it is computed, like GEMM's `C` update:
+ * `clamp(alpha * acc + beta * bias, min, max)`. The bias is the optional
+ * third input of the Matmul.
+ */
+struct MatmulEpilogue {
+  float alpha = 1.f, beta = 1.f;
+  // Relu folds into `min = 0`.
+  optional<float> min, max;
+
+  [[nodiscard]] bool hasClamp() const { return min || max; }
+  /**
+   * @brief Compose `clamp(x, min, max)` after this epilogue. Returns false if
+   * the composition is not a single clamp.
+   */
+  bool composeClamp(optional<float> newMin, optional<float> newMax);
+};
+
+/**
+ * @brief A constant B of a Matmul packed by a kernel into panels of `panel`
+ * columns, each holding its rows one after the other. Valid while B keeps its
+ * FUID and data version and the kernel its blocking.
+ */
+struct MatmulPackedB {
+  UidBaseType fuid = -1;
+  uint64_t version = 0;
+  size_t panel = 0;
+  bool transB = false;
+  vector<uint8_t> data;
+  // 128 times the column sums of an Int8 B, see the Int8 kernel.
+  vector<int32_t> colSums;
+
+  MatmulPackedB() = default;
+  // A cloned operator reads other tensors and packs its own.
+  MatmulPackedB(const MatmulPackedB &) {}
+  MatmulPackedB &operator=(const MatmulPackedB &) { return *this; }
+};
+
 /**
  * @brief Matrix multiplication.
  *
@@ -13,9 +52,12 @@ private:
   // default dims, true means A should be transposed before matmul. This is in
   // oppsite to the column-major BLAS.
   bool transA, transB;
+  MatmulEpilogue epilogue;
 
   // Auxiliary attributes which are not a part of operator attributes.
   int m{}, n{}, k{};
+  // Filled by the CPU kernel, see Kernel::prepare.
+  mutable MatmulPackedB packedB;
 
 public:
   /**
@@ -25,6 +67,9 @@ public:
    * dimensions should be transposed before Matmul and does not affect other
    * leading dimensions.
    *
+   * Int8 A and B multiply into an Int32 C, without a bias or an epilogue
+   * and with an unbatched B.
+   *
    * Matmul show how operators are defined in InfiniTensor. The constructor of
    * an operator can create output tensors for the operator or not, which
    * depends on `graph`.
@@ -36,24 +81,39 @@ public:
    * the constructor, C should be an empty Ref.
    * @param transA If matrix A should be transposed when computing.
    * @param transB If matrix B should be transposed when computing.
+   * @param bias Optional tensor broadcast-added to C by the epilogue. When
+   * it has the shape of C, C may be written into its buffer.
+   * @param epilogue Scaling of the product and the bias, and clamp applied
+   * after the bias.
    */
   MatmulObj(GraphObj *graph, Tensor A, Tensor B, Tensor C, bool transA = false,
-            bool transB = false);
+            bool transB = false, Tensor bias = nullptr,
+            MatmulEpilogue epilogue = {});
   OP_CLONE(MatmulObj);
 
   [[nodiscard]] std::string toString() const override;
   optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+  [[nodiscard]] vector<DataType>
+  inferDataType(const TensorVec &inputs) const override;
 
   [[nodiscard]] int numInputs() const override { return (int)inputs.size(); }
   [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getInplaceInput() const override;
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
 
   [[nodiscard]] bool getTransA() const { return transA; }
   [[nodiscard]] bool getTransB() const { return transB; }
   void setTransA(bool transA) { this->transA = transA; }
   void setTransB(bool transB) { this->transB = transB; }
+  [[nodiscard]] Tensor getBias() const {
+    return inputs.size() > 2 ? inputs[2] : nullptr;
+  }
+  [[nodiscard]] const MatmulEpilogue &getEpilogue() const { return epilogue; }
   [[nodiscard]] int getM() const { return m; }
   [[nodiscard]] int getN() const { return n; }
   [[nodiscard]] int getK() const { return k; }
+  [[nodiscard]] MatmulPackedB &getPackedB() const { return packedB; }
 };
 
 } // namespace infini
\ No newline at end of file
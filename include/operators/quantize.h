@@ -0,0 +1,93 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini {
+
+/**
+ * @brief Quantize a Float32 tensor to Int8 or UInt8 similar to onnx
+ * QuantizeLinear: `saturate(round(x / scale) + zeroPoint)`, rounding half to
+ * even. The scale and zero point hold one value for the whole tensor, or one
+ * per index of `axis`.
+ */
+class QuantizeLinearObj : public OperatorObj {
+  int axis;
+
+public:
+  /**
+   * @brief Construct a new QuantizeLinear object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The Float32 input tensor.
+   * @param scale The Float32 scale, a scalar or a 1-D tensor of the size of
+   * `axis`.
+   * @param zeroPoint The zero point with the shape of `scale`, whose type is
+   * the output type. Optional: 0 of type UInt8 by default.
+   * @param output The quantized output tensor.
+   * @param axis The dimension of a per-channel scale.
+   */
+  QuantizeLinearObj(GraphObj *graph, Tensor input, Tensor scale,
+                    Tensor zeroPoint, Tensor output, int axis = 1);
+  OP_CLONE(QuantizeLinearObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+  [[nodiscard]] vector<DataType>
+  inferDataType(const TensorVec &inputs) const override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override {
+    return static_cast<int>(inputs.size());
+  }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] int getAxis() const { return axis; }
+  [[nodiscard]] const Tensor &getScale() const { return inputs[1]; }
+  [[nodiscard]] Tensor getZeroPoint() const {
+    return inputs.size() > 2 ? inputs[2] : nullptr;
+  }
+  [[nodiscard]] bool isPerChannel() const { return inputs[1]->size() != 1; }
+};
+
+/**
+ * @brief Dequantize an Int8, UInt8 or Int32 tensor to Float32 similar to onnx
+ * DequantizeLinear: `(x - zeroPoint) * scale`, with the scale and zero point
+ * of QuantizeLinearObj.
+ */
+class DequantizeLinearObj : public OperatorObj {
+  int axis;
+
+public:
+  /**
+   * @brief Construct a new DequantizeLinear object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The quantized input tensor.
+   * @param scale The Float32 scale, a scalar or a 1-D tensor of the size of
+   * `axis`.
+   * @param zeroPoint The zero point with the shape of `scale` and the type of
+   * `input`. Optional: 0 by default.
+   * @param output The Float32 output tensor.
+   * @param axis The dimension of a per-channel scale.
+   */
+  DequantizeLinearObj(GraphObj *graph, Tensor input, Tensor scale,
+                      Tensor zeroPoint, Tensor output, int axis = 1);
+  OP_CLONE(DequantizeLinearObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+  [[nodiscard]] vector<DataType>
+  inferDataType(const TensorVec &inputs) const override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override {
+    return static_cast<int>(inputs.size());
+  }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] int getAxis() const { return axis; }
+  [[nodiscard]] const Tensor &getScale() const { return inputs[1]; }
+  [[nodiscard]] Tensor getZeroPoint() const {
+    return inputs.size() > 2 ? inputs[2] : nullptr;
+  }
+  [[nodiscard]] bool isPerChannel() const { return inputs[1]->size() != 1; }
+};
+
+} // namespace infini
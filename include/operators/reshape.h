@@ -0,0 +1,136 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini {
+
+/**
+ * @brief Give the input tensor a new shape with the same number of elements,
+ * similar to onnx Reshape. The output is a view of the input.
+ */
+class ReshapeObj : public OperatorObj {
+  Shape dims;
+
+public:
+  /**
+   * @brief Construct a new Reshape object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param output The output tensor.
+   * @param dims The new shape. 0 copies the dimension of the input at the
+   * same index, and a single -1 is inferred from the number of elements.
+   */
+  ReshapeObj(GraphObj *graph, Tensor input, Tensor output, Shape dims);
+  OP_CLONE(ReshapeObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override { return 1; }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool preservesContiguity() const override { return true; }
+  [[nodiscard]] const Shape &getShape() const { return dims; }
+};
+
+/**
+ * @brief Flatten the input tensor into a matrix, similar to onnx Flatten.
+ * The output is a view of the input.
+ */
+class FlattenObj : public OperatorObj {
+  int axis;
+
+public:
+  /**
+   * @brief Construct a new Flatten object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param output The output tensor.
+   * @param axis The dimensions before `axis` make the rows of the output,
+   * the others its columns.
+   */
+  FlattenObj(GraphObj *graph, Tensor input, Tensor output, int axis = 1);
+  OP_CLONE(FlattenObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override { return 1; }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool preservesContiguity() const override { return true; }
+  [[nodiscard]] int getAxis() const { return axis; }
+};
+
+/**
+ * @brief Remove dimensions of size 1 from the input tensor, similar to onnx
+ * Squeeze. The output is a view of the input.
+ */
+class SqueezeObj : public OperatorObj {
+  vector<int> axes;
+
+public:
+  /**
+   * @brief Construct a new Squeeze object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param output The output tensor.
+   * @param axes The dimensions to remove. Empty to remove every dimension of
+   * size 1.
+   */
+  SqueezeObj(GraphObj *graph, Tensor input, Tensor output,
+             vector<int> axes = {});
+  OP_CLONE(SqueezeObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override { return 1; }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool preservesContiguity() const override { return true; }
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
+  [[nodiscard]] const vector<int> &getAxes() const { return axes; }
+};
+
+/**
+ * @brief Insert dimensions of size 1 into the input tensor, similar to onnx
+ * Unsqueeze. The output is a view of the input.
+ */
+class UnsqueezeObj : public OperatorObj {
+  vector<int> axes;
+
+public:
+  /**
+   * @brief Construct a new Unsqueeze object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param output The output tensor.
+   * @param axes The indices of the new dimensions in the output.
+   */
+  UnsqueezeObj(GraphObj *graph, Tensor input, Tensor output, vector<int> axes);
+  OP_CLONE(UnsqueezeObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override { return 1; }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool preservesContiguity() const override { return true; }
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
+  [[nodiscard]] const vector<int> &getAxes() const { return axes; }
+};
+
+} // namespace infini
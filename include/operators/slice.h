@@ -0,0 +1,48 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini {
+
+/**
+ * @brief Take a strided range of every dimension of the input tensor, similar
+ * to onnx Slice. The output is a view of the input.
+ */
+class SliceObj : public OperatorObj {
+  // One of each per input dimension, normalized against the input shape.
+  vector<int> starts, ends, steps;
+
+public:
+  /**
+   * @brief Construct a new Slice object.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param output The output tensor.
+   * @param starts The first index taken along each of `axes`. Negative
+   * indices count from the end, and indices out of range are clamped.
+   * @param ends The index to stop before along each of `axes`, like `starts`.
+   * @param axes The sliced dimensions, every dimension by default.
+   * @param steps The positive steps along each of `axes`, 1 by default.
+   */
+  SliceObj(GraphObj *graph, Tensor input, Tensor output,
+           const vector<int> &starts, const vector<int> &ends,
+           const optional<vector<int>> &axes = std::nullopt,
+           const optional<vector<int>> &steps = std::nullopt);
+  OP_CLONE(SliceObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override { return 1; }
+  [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool preservesContiguity() const override;
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
+  [[nodiscard]] const vector<int> &getStarts() const { return starts; }
+  [[nodiscard]] const vector<int> &getEnds() const { return ends; }
+  [[nodiscard]] const vector<int> &getSteps() const { return steps; }
+};
+
+} // namespace infini
@@ -0,0 +1,57 @@
+#pragma once
+#include "core/operator.h"
+
+namespace infini {
+
+/**
+ * @brief Split the input tensor into several along one dimension, similar to
+ * onnx Split. The outputs are views of the input.
+ */
+class SplitObj : public OperatorObj {
+  int dim;
+  // The size of each output along `dim`.
+  vector<int> sizes;
+
+public:
+  /**
+   * @brief Construct a new Split object that splits the input evenly.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param outputs The output tensors, or std::nullopt to create them.
+   * @param dim The dimension to split.
+   * @param num The number of outputs, which must divide the size of `dim`.
+   */
+  SplitObj(GraphObj *graph, Tensor input, const optional<TensorVec> &outputs,
+           int dim, int num);
+  /**
+   * @brief Construct a new Split object with outputs of the given sizes.
+   *
+   * @param graph The computation graph that this operator belongs to.
+   * @param input The input tensor.
+   * @param outputs The output tensors, or std::nullopt to create them.
+   * @param dim The dimension to split.
+   * @param sizes The size of each output along `dim`, which add up to the
+   * size of `dim`.
+   */
+  SplitObj(GraphObj *graph, Tensor input, const optional<TensorVec> &outputs,
+           int dim, vector<int> sizes);
+  OP_CLONE(SplitObj);
+
+  optional<vector<Shape>> inferShape(const TensorVec &inputs) override;
+
+  [[nodiscard]] std::string toString() const override;
+  [[nodiscard]] int numInputs() const override { return 1; }
+  [[nodiscard]] int numOutputs() const override {
+    return static_cast<int>(sizes.size());
+  }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool preservesContiguity() const override;
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
+  [[nodiscard]] int getDim() const { return dim; }
+  [[nodiscard]] const vector<int> &getSizes() const { return sizes; }
+};
+
+} // namespace infini
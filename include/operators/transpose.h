@@ -25,6 +25,10 @@ public:
   [[nodiscard]] std::string toString() const override;
   [[nodiscard]] int numInputs() const override { return 1; }
   [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
+  [[nodiscard]] optional<int> getViewInput() const override { return 0; }
+  [[nodiscard]] std::pair<Strides, size_t> inferView(size_t i) const override;
+  [[nodiscard]] bool supportsStridedInputs() const override { return true; }
   [[nodiscard]] std::vector<int> getPermute() const { return transposePermute; }
 
 private:
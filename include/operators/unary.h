@@ -38,6 +38,7 @@ public:
   [[nodiscard]] std::optional<float> getMax() const { return maxValue; };
   [[nodiscard]] int numInputs() const override { return 1; }
   [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
 
 private:
   std::optional<float> minValue, maxValue;
@@ -81,9 +82,18 @@ public:
 
   [[nodiscard]] std::string toString() const override;
   [[nodiscard]] CastType getType() const { return castType; }
+  [[nodiscard]] DataType getInputDataType() const;
   [[nodiscard]] DataType getOutputDataType() const;
+  [[nodiscard]] static DataType getInputDataType(CastType type);
+  [[nodiscard]] static DataType getOutputDataType(CastType type);
+  /**
+   * @brief The CastType converting `from` to `to`, if there is one.
+   */
+  [[nodiscard]] static optional<CastType> getCastType(DataType from,
+                                                      DataType to);
   [[nodiscard]] int numInputs() const override { return 1; }
   [[nodiscard]] int numOutputs() const override { return 1; }
+  [[nodiscard]] vector<int> getOpAttrVector() const override;
 
 private:
   CastType castType;
@@ -15,7 +15,18 @@ int get_real_axis(const int &axis, const int &rank);
 Shape locate_index(size_t inputN, const Shape &shape);
 // Delocate the ShapeIndex from Shape with broadcast
 size_t delocate_index(const Shape &shapeIndex, const Shape &shape,
-                      const Shape &stride);
+                      const Strides &stride);
+// Strides of `tensor` right-aligned to rank `rank`, 0 along broadcast
+// dimensions
+Strides broadcast_strides(const Tensor &tensor, size_t rank);
+// Copy the elements of shape `dims` from `src` to `dst`, each laid out by its
+// own strides in elements of `elemSize` bytes. Trailing dimensions contiguous
+// in both layouts are copied as one memcpy run.
+void copy_strided(uint8_t *dst, const Strides &dstStrides, const uint8_t *src,
+                  const Strides &srcStrides, const Shape &dims,
+                  size_t elemSize);
+// Append an optional float attribute to an attribute vector
+void append_attr(vector<int> &attrs, const optional<float> &value);
 // Convert KernelAttrs to a string representation
 std::string get_kernel_attrs_str(const KernelAttrs &kernelAttrs);
 
@@ -0,0 +1,268 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace infini {
+
+/**
+ * @brief A vector of trivially copyable elements that keeps up to N of them
+ * inline and only allocates beyond that. It converts to and from
+ * std::vector, so it can stand in for one in existing interfaces.
+ */
+template <typename T, size_t N> class SmallVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SmallVector only holds trivially copyable elements");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+  T *ptr;
+  size_t len = 0;
+  size_t cap = N;
+  T buffer[N]{};
+
+  [[nodiscard]] bool isInline() const { return ptr == buffer; }
+
+  void grow(size_t minCap) {
+    if (minCap <= cap) {
+      return;
+    }
+    auto newCap = std::max(minCap, cap * 2);
+    auto *newPtr = new T[newCap];
+    std::copy(ptr, ptr + len, newPtr);
+    if (!isInline()) {
+      delete[] ptr;
+    }
+    ptr = newPtr;
+    cap = newCap;
+  }
+
+  // Opens a gap of `count` elements at `index` and returns its start.
+  iterator openGap(size_t index, size_t count) {
+    grow(len + count);
+    std::copy_backward(ptr + index, ptr + len, ptr + len + count);
+    len += count;
+    return ptr + index;
+  }
+
+public:
+  SmallVector() : ptr(buffer) {}
+  explicit SmallVector(size_t count, const T &value = T()) : ptr(buffer) {
+    assign(count, value);
+  }
+  SmallVector(std::initializer_list<T> init) : ptr(buffer) {
+    assign(init.begin(), init.end());
+  }
+  template <typename It, typename = typename std::iterator_traits<
+                             It>::iterator_category>
+  SmallVector(It first, It last) : ptr(buffer) {
+    assign(first, last);
+  }
+  SmallVector(const std::vector<T> &vec) : ptr(buffer) {
+    assign(vec.begin(), vec.end());
+  }
+  SmallVector(const SmallVector &other) : ptr(buffer) {
+    assign(other.begin(), other.end());
+  }
+  SmallVector(SmallVector &&other) noexcept : ptr(buffer) {
+    *this = std::move(other);
+  }
+  ~SmallVector() {
+    if (!isInline()) {
+      delete[] ptr;
+    }
+  }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      assign(other.begin(), other.end());
+    }
+    return *this;
+  }
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    if (other.isInline()) {
+      std::copy(other.begin(), other.end(), buffer);
+      if (!isInline()) {
+        delete[] ptr;
+      }
+      ptr = buffer;
+      cap = N;
+    } else {
+      // Take over the heap buffer.
+      if (!isInline()) {
+        delete[] ptr;
+      }
+      ptr = other.ptr;
+      cap = other.cap;
+      other.ptr = other.buffer;
+      other.cap = N;
+    }
+    len = other.len;
+    other.len = 0;
+    return *this;
+  }
+  SmallVector &operator=(std::initializer_list<T> init) {
+    assign(init.begin(), init.end());
+    return *this;
+  }
+
+  operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+  void assign(size_t count, const T &value) {
+    clear();
+    grow(count);
+    std::fill(ptr, ptr + count, value);
+    len = count;
+  }
+  template <typename It, typename = typename std::iterator_traits<
+                             It>::iterator_category>
+  void assign(It first, It last) {
+    clear();
+    insert(end(), first, last);
+  }
+
+  [[nodiscard]] iterator begin() { return ptr; }
+  [[nodiscard]] iterator end() { return ptr + len; }
+  [[nodiscard]] const_iterator begin() const { return ptr; }
+  [[nodiscard]] const_iterator end() const { return ptr + len; }
+  [[nodiscard]] const_iterator cbegin() const { return ptr; }
+  [[nodiscard]] const_iterator cend() const { return ptr + len; }
+  [[nodiscard]] reverse_iterator rbegin() { return reverse_iterator(end()); }
+  [[nodiscard]] reverse_iterator rend() { return reverse_iterator(begin()); }
+  [[nodiscard]] const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  [[nodiscard]] const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  [[nodiscard]] size_t size() const { return len; }
+  [[nodiscard]] bool empty() const { return len == 0; }
+  [[nodiscard]] size_t capacity() const { return cap; }
+  [[nodiscard]] T *data() { return ptr; }
+  [[nodiscard]] const T *data() const { return ptr; }
+
+  T &operator[](size_t i) { return ptr[i]; }
+  const T &operator[](size_t i) const { return ptr[i]; }
+  T &at(size_t i) {
+    if (i >= len) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return ptr[i];
+  }
+  [[nodiscard]] const T &at(size_t i) const {
+    if (i >= len) {
+      throw std::out_of_range("SmallVector::at");
+    }
+    return ptr[i];
+  }
+  T &front() { return ptr[0]; }
+  [[nodiscard]] const T &front() const { return ptr[0]; }
+  T &back() { return ptr[len - 1]; }
+  [[nodiscard]] const T &back() const { return ptr[len - 1]; }
+
+  void reserve(size_t count) { grow(count); }
+  void clear() { len = 0; }
+  void resize(size_t count, const T &value = T()) {
+    grow(count);
+    if (count > len) {
+      std::fill(ptr + len, ptr + count, value);
+    }
+    len = count;
+  }
+  void push_back(const T &value) {
+    grow(len + 1);
+    ptr[len++] = value;
+  }
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    grow(len + 1);
+    ptr[len] = T(std::forward<Args>(args)...);
+    return ptr[len++];
+  }
+  void pop_back() { --len; }
+
+  iterator insert(const_iterator pos, const T &value) {
+    auto copy = value;
+    auto *gap = openGap(pos - begin(), 1);
+    *gap = copy;
+    return gap;
+  }
+  iterator insert(const_iterator pos, size_t count, const T &value) {
+    auto copy = value;
+    auto *gap = openGap(pos - begin(), count);
+    std::fill(gap, gap + count, copy);
+    return gap;
+  }
+  template <typename It, typename = typename std::iterator_traits<
+                             It>::iterator_category>
+  iterator insert(const_iterator pos, It first, It last) {
+    if constexpr (std::is_pointer_v<It>) {
+      // A range inside this vector may move when it grows.
+      if (first >= cbegin() && first < cend()) {
+        std::vector<T> values(first, last);
+        return insert(pos, values.begin(), values.end());
+      }
+    }
+    auto *gap = openGap(pos - begin(), std::distance(first, last));
+    std::copy(first, last, gap);
+    return gap;
+  }
+  iterator insert(const_iterator pos, std::initializer_list<T> init) {
+    return insert(pos, init.begin(), init.end());
+  }
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    auto *dst = begin() + (first - begin());
+    std::copy(last, cend(), dst);
+    len -= last - first;
+    return dst;
+  }
+
+  friend bool operator==(const SmallVector &a, const SmallVector &b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+  friend bool operator!=(const SmallVector &a, const SmallVector &b) {
+    return !(a == b);
+  }
+  friend bool operator<(const SmallVector &a, const SmallVector &b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(),
+                                        b.end());
+  }
+};
+
+template <typename T, size_t N>
+std::string vecToString(const SmallVector<T, N> &vec) {
+  std::stringstream ss;
+  ss << "[";
+  for (size_t i = 0; i < vec.size(); ++i) {
+    ss << vec[i];
+    if (i < vec.size() - 1) {
+      ss << ",";
+    }
+  }
+  ss << "]";
+  return ss.str();
+}
+
+} // namespace infini
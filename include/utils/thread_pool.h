@@ -0,0 +1,47 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace infini {
+
+/**
+ * @brief A fixed-size pool of worker threads draining a FIFO task queue.
+ * Tasks still queued when the pool is destroyed are executed before the
+ * workers are joined. A task may destroy the pool, e.g. by releasing the
+ * last reference to its owner; its own worker then exits on its own.
+ */
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+private:
+  // Shared with the workers, which may outlive the pool.
+  struct State {
+    std::deque<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+  };
+  std::shared_ptr<State> state;
+  std::vector<std::thread> workers;
+
+public:
+  explicit ThreadPool(size_t nThreads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  void submit(Task task);
+  [[nodiscard]] size_t size() const { return workers.size(); }
+
+private:
+  static void workerLoop(const std::shared_ptr<State> &state);
+};
+
+} // namespace infini
@@ -40,7 +40,9 @@ size_t Allocator::alloc(size_t size) {
     allocated[offset] = size;
 
     used += size;
-    peak = std::max(peak, used);
+    // Freed blocks may be too small to reuse, so the arena has to reach the
+    // end of the highest block, which can be more than `used` ever was.
+    peak = std::max(peak, offset + size);
 
     auto remaining = it->second - size;
     if (remaining > 0) {
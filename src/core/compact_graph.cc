@@ -0,0 +1,71 @@
+#include "core/compact_graph.h"
+#include <unordered_map>
+
+namespace infini {
+
+CompactGraph::CompactGraph(const GraphObj &graph)
+    : ops(graph.getOperators()), tensors(graph.getTensors()) {
+  IT_ASSERT(ops.size() < None && tensors.size() < None,
+            "Graph too large for 32-bit handles");
+  std::unordered_map<const TensorObj *, Index> tensorIndex;
+  tensorIndex.reserve(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    tensorIndex.emplace(tensors[i].get(), static_cast<Index>(i));
+    bytes.emplace_back(tensors[i]->getBytes());
+  }
+  auto indexOf = [&](const Tensor &t) {
+    auto it = tensorIndex.find(t.get());
+    IT_ASSERT(it != tensorIndex.end(), "Operand is not a tensor of the graph");
+    return it->second;
+  };
+
+  sources.assign(tensors.size(), None);
+  for (size_t i = 0; i < ops.size(); ++i) {
+    opTypes.emplace_back(ops[i]->getOpType());
+    for (const auto &t : ops[i]->getOutputs()) {
+      auto index = indexOf(t);
+      sources[index] = static_cast<Index>(i);
+      outputs.indices.emplace_back(index);
+    }
+    outputs.endRow();
+  }
+
+  // Tensor consumers and operator producers, both from the operand lists.
+  vector<vector<Index>> readers(tensors.size());
+  vector<vector<Index>> consumers(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto op = static_cast<Index>(i);
+    auto begin = predecessors.indices.size();
+    for (const auto &t : ops[i]->getInputs()) {
+      auto index = indexOf(t);
+      inputs.indices.emplace_back(index);
+      if (readers[index].empty() || readers[index].back() != op) {
+        readers[index].emplace_back(op);
+      }
+      if (sources[index] != None) {
+        predecessors.indices.emplace_back(sources[index]);
+      }
+    }
+    inputs.endRow();
+    auto first = predecessors.indices.begin() + begin;
+    std::sort(first, predecessors.indices.end());
+    predecessors.indices.erase(std::unique(first, predecessors.indices.end()),
+                               predecessors.indices.end());
+    for (auto it = first; it != predecessors.indices.end(); ++it) {
+      consumers[*it].emplace_back(op);
+    }
+    predecessors.endRow();
+  }
+  // Both are filled in ascending operator order, so rows are sorted.
+  for (const auto &row : readers) {
+    targets.indices.insert(targets.indices.end(), row.begin(), row.end());
+    targets.endRow();
+  }
+  for (const auto &row : consumers) {
+    successors.indices.insert(successors.indices.end(), row.begin(),
+                              row.end());
+    successors.endRow();
+  }
+}
+
+} // namespace infini
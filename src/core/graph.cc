@@ -1,10 +1,10 @@
 #include "core/graph.h"
 #include "core/common.h"
+#include "core/compact_graph.h"
 #include "core/object.h"
 #include "core/ref.h"
+#include "core/rewriter.h"
 #include "core/runtime.h"
-#include "operators/matmul.h"
-#include "operators/transpose.h"
 #include <algorithm>
 #include <cstddef>
 #include <string>
@@ -14,9 +14,171 @@
 
 namespace infini {
 
+namespace {
+using Index = CompactGraph::Index;
+
+// The buffers of a graph in topological order and when they can be released:
+// after the last operator reading them, unless they hold a graph input, a
+// constant or a graph output. Outputs computed in place share the buffer of
+// the input they overwrite, which only an intermediate result nothing else
+// reads may be. Views share the buffer of the input they read and keep it
+// alive. Contiguous ones are always taken, others when every consumer reads
+// through strides. Views are never overwritten in place.
+class Liveness {
+  const CompactGraph &graph;
+  // Tensor owning the buffer of every tensor.
+  vector<Index> owners;
+  vector<bool> views;
+  // Views that may not be contiguous.
+  vector<bool> strided;
+  vector<bool> pinned;
+  // Operators yet to read each buffer.
+  vector<size_t> uses;
+
+public:
+  Liveness(const GraphObj &g, const CompactGraph &graph)
+      : graph(graph), views(graph.numTensors(), false),
+        strided(graph.numTensors(), false), pinned(graph.numTensors(), false),
+        uses(graph.numTensors(), 0) {
+    for (Index t = 0; t < graph.numTensors(); ++t) {
+      owners.emplace_back(t);
+    }
+    auto stridedReads = [&](Index t) {
+      auto targets = graph.getTargets(t);
+      return !targets.empty() &&
+             std::all_of(targets.begin(), targets.end(), [&](Index op) {
+               return graph.getOperator(op)->supportsStridedInputs();
+             });
+    };
+    // In topological order, so that views of views see their input's owner.
+    for (Index op = 0; op < graph.numOperators(); ++op) {
+      const auto &obj = graph.getOperator(op);
+      auto inputs = graph.getInputs(op);
+      auto outputs = graph.getOutputs(op);
+      if (auto index = obj->getViewInput()) {
+        auto input = inputs[*index];
+        auto isStrided = strided[input] || !obj->preservesContiguity();
+        for (auto output : outputs) {
+          if (!isStrided ||
+              (!g.isOutput(graph.getTensor(output)) && stridedReads(output))) {
+            owners[output] = owners[input];
+            views[output] = true;
+            strided[output] = isStrided;
+          }
+        }
+        continue;
+      }
+      auto index = obj->getInplaceInput();
+      if (!index || outputs.size() != 1) {
+        continue;
+      }
+      auto input = inputs[*index];
+      auto output = outputs[0];
+      if (graph.getSource(input) == CompactGraph::None || views[input] ||
+          graph.getTargets(input).size() != 1 ||
+          std::count(inputs.begin(), inputs.end(), input) != 1 ||
+          g.isOutput(graph.getTensor(input)) ||
+          graph.getBytes(input) != graph.getBytes(output)) {
+        continue;
+      }
+      owners[output] = owners[input];
+    }
+    for (Index t = 0; t < graph.numTensors(); ++t) {
+      if (graph.getSource(t) == CompactGraph::None ||
+          g.isOutput(graph.getTensor(t))) {
+        pinned[owners[t]] = true;
+      }
+    }
+    for (Index op = 0; op < graph.numOperators(); ++op) {
+      for (auto t : reads(op)) {
+        ++uses[t];
+      }
+    }
+  }
+
+  [[nodiscard]] Index owner(Index t) const { return owners[t]; }
+  [[nodiscard]] bool isView(Index t) const { return views[t]; }
+
+  // Buffers `op` allocates for its outputs.
+  [[nodiscard]] vector<Index> allocated(Index op) const {
+    vector<Index> ret;
+    for (auto t : graph.getOutputs(op)) {
+      if (owners[t] == t) {
+        ret.emplace_back(t);
+      }
+    }
+    return ret;
+  }
+
+  // Buffers that can be released once `op` ran, if it runs next.
+  [[nodiscard]] vector<Index> released(Index op) const {
+    vector<Index> ret;
+    for (auto t : reads(op)) {
+      if (uses[t] == 1 && !pinned[t]) {
+        ret.emplace_back(t);
+      }
+    }
+    // Outputs nothing reads.
+    for (auto t : allocated(op)) {
+      if (uses[t] == 0 && !pinned[t]) {
+        ret.emplace_back(t);
+      }
+    }
+    return ret;
+  }
+
+  void run(Index op) {
+    for (auto t : reads(op)) {
+      --uses[t];
+    }
+  }
+
+  [[nodiscard]] size_t totalBytes(const vector<Index> &buffers) const {
+    size_t ret = 0;
+    for (auto t : buffers) {
+      ret += graph.getBytes(t);
+    }
+    return ret;
+  }
+
+private:
+  // Distinct buffers `op` reads.
+  [[nodiscard]] vector<Index> reads(Index op) const {
+    vector<Index> ret;
+    for (auto t : graph.getInputs(op)) {
+      if (std::find(ret.begin(), ret.end(), owners[t]) == ret.end()) {
+        ret.emplace_back(owners[t]);
+      }
+    }
+    return ret;
+  }
+};
+} // namespace
+
+GraphObj::GraphObj(const Runtime &runtime, const OpVec &ops_in)
+    : runtime(runtime), allocator(runtime) {
+  std::unordered_map<UidBaseType, Tensor> tensorPool;
+  auto cloneTensor = [&](const Tensor &t) {
+    auto [it, inserted] = tensorPool.try_emplace(t->getFuid());
+    if (inserted) {
+      it->second = addTensor(t->clone());
+    }
+    return it->second;
+  };
+  for (const auto &op : ops_in) {
+    TensorVec inputs;
+    TensorVec outputs;
+    for (const auto &t : op->getInputs()) {
+      inputs.emplace_back(cloneTensor(t));
+    }
+    for (const auto &t : op->getOutputs()) {
+      outputs.emplace_back(cloneTensor(t));
+    }
+    addOpClone(op, inputs, outputs);
+  }
+}
+
 void GraphObj::addOperatorAndConnect(const Operator &op) {
-  sorted = false;
-  ops.push_back(op);
   for (const auto &input : op->getInputs()) {
     if (input) {
       input->addTarget(op);
@@ -35,9 +197,99 @@ void GraphObj::addOperatorAndConnect(const Operator &op) {
       }
     }
   }
+  placeOperator(op);
+}
+
+void GraphObj::placeOperator(const Operator &op) {
+  if (sorted && !op->successors.empty()) {
+    // `op` writes tensors that are already read. A rewrite usually leaves the
+    // slot of an erased operator right before the first consumer, which keeps
+    // the order topological if all producers come earlier. Otherwise the
+    // next topo_sort() restores the order, instead of shifting `ops` here.
+    auto first = ops.size();
+    for (const auto &succ : op->successors) {
+      auto it = opSlots.find(succ.lock()->getGuid());
+      if (it != opSlots.end()) {
+        first = std::min(first, it->second);
+      }
+    }
+    auto free = first > 0 && first < ops.size() && !ops[first - 1];
+    for (const auto &pred : op->predecessors) {
+      auto it = opSlots.find(pred.lock()->getGuid());
+      free = free && (it == opSlots.end() || it->second < first - 1);
+    }
+    if (free) {
+      opSlots[op->getGuid()] = first - 1;
+      ops[first - 1] = op;
+      --deadOps;
+      return;
+    }
+    sorted = first == ops.size();
+  }
+  opSlots[op->getGuid()] = ops.size();
+  ops.push_back(op);
+}
+
+void GraphObj::removeOperator(const Operator &op) {
+  auto it = opSlots.find(op->getGuid());
+  if (it != opSlots.end() && ops[it->second] == op) {
+    ops[it->second] = nullptr;
+    opSlots.erase(it);
+    ++deadOps;
+  }
+}
+
+void GraphObj::removeTensor(const Tensor &tensor) {
+  auto it = tensorSlots.find(tensor->getFuid());
+  if (it != tensorSlots.end() && tensors[it->second] == tensor) {
+    tensors[it->second] = nullptr;
+    tensorSlots.erase(it);
+    ++deadTensors;
+  } else if (auto t = std::find(tensors.begin(), tensors.end(), tensor);
+             t != tensors.end()) {
+    // A second tensor with the same FUID, which checkValid() rejects.
+    *t = nullptr;
+    ++deadTensors;
+  }
+}
+
+bool GraphObj::hasTensor(const Tensor &tensor) const {
+  auto it = tensorSlots.find(tensor->getFuid());
+  return it != tensorSlots.end() && tensors[it->second] == tensor;
+}
+
+bool GraphObj::hasOperator(const Operator &op) const {
+  auto it = opSlots.find(op->getGuid());
+  return it != opSlots.end() && ops[it->second] == op;
+}
+
+void GraphObj::compact() const {
+  if (deadOps > 0) {
+    ops.erase(std::remove(ops.begin(), ops.end(), nullptr), ops.end());
+    deadOps = 0;
+    reindexOperators();
+  }
+  if (deadTensors > 0) {
+    tensors.erase(std::remove(tensors.begin(), tensors.end(), nullptr),
+                  tensors.end());
+    deadTensors = 0;
+    tensorSlots.clear();
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      tensorSlots.emplace(tensors[i]->getFuid(), i);
+    }
+  }
+}
+
+void GraphObj::reindexOperators() const {
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i]) {
+      opSlots[ops[i]->getGuid()] = i;
+    }
+  }
 }
 
 string GraphObj::toString() const {
+  compact();
   std::ostringstream oss;
   oss << "┌─[Graph Tensors]" << "\n";
   for (const auto &tensor : tensors) {
@@ -65,192 +317,178 @@ string GraphObj::toString() const {
   return oss.str();
 }
 
+OpVec GraphObj::kahnSort() const {
+  CompactGraph graph(*this);
+  auto n = static_cast<Index>(graph.numOperators());
+  auto inOrder = true;
+  vector<size_t> inDegree;
+  inDegree.reserve(n);
+  for (Index op = 0; op < n; ++op) {
+    auto preds = graph.getPredecessors(op);
+    inDegree.emplace_back(preds.size());
+    // Rows are sorted, so the last producer is the latest one.
+    inOrder = inOrder && (preds.empty() || preds[preds.size() - 1] < op);
+  }
+  if (inOrder) {
+    return ops;
+  }
+
+  OpVec order;
+  order.reserve(n);
+  vector<Index> queue;
+  queue.reserve(n);
+  for (Index op = 0; op < n; ++op) {
+    if (inDegree[op] == 0) {
+      queue.emplace_back(op);
+    }
+  }
+  for (size_t head = 0; head < queue.size(); ++head) {
+    order.emplace_back(graph.getOperator(queue[head]));
+    for (auto c : graph.getSuccessors(queue[head])) {
+      if (--inDegree[c] == 0) {
+        queue.emplace_back(c);
+      }
+    }
+  }
+  return order;
+}
+
 bool GraphObj::topo_sort() {
+  compact();
   if (this->sorted) {
     return true;
   }
-  std::vector<Operator> sorted;
-  std::unordered_set<OperatorObj *> flags;
-  sorted.reserve(ops.size());
-  flags.reserve(ops.size());
-  while (sorted.size() < ops.size()) {
-    // Any node is move to sorted in this loop.
-    auto modified = false;
-    for (auto const &op : ops) {
-      if (auto const &inputs = op->getInputs();
-          flags.find(op.get()) == flags.end() &&
-          std::all_of(inputs.begin(), inputs.end(),
-                      [&flags](auto const &input) {
-                        auto ptr = input->getSource().get();
-                        return !ptr || flags.find(ptr) != flags.end();
-                      })) {
-        modified = true;
-        sorted.emplace_back(op);
-        flags.insert(op.get());
-      }
-    }
-    if (!modified) {
-      return false;
-    }
+  auto order = kahnSort();
+  if (order.size() < ops.size()) {
+    return false;
   }
-  this->ops = std::move(sorted);
+  this->ops = std::move(order);
+  reindexOperators();
   return this->sorted = true;
 }
 
-void GraphObj::optimize() {
-  using GuidType = decltype(ops[0]->getGuid());
-
-  std::unordered_map<GuidType, Operator> op_map;
-  std::unordered_map<GuidType, Tensor> tensor_map;
-  std::unordered_map<GuidType, size_t> op_i_map;
-  std::unordered_map<GuidType, size_t> tensor_i_map;
-  std::unordered_set<GuidType> erased_ops;
-  std::unordered_set<GuidType> erased_tensors;
-
-  size_t op_i = 0;
-  for (auto &op : ops) {
-    op_map[op->getGuid()] = op;
-    op_i_map[op->getGuid()] = op_i++;
+OpVec GraphObj::findCycle() const {
+  auto order = kahnSort();
+  if (order.size() == ops.size()) {
+    return {};
   }
-
-  size_t tensor_i = 0;
-  for (auto &tensor : tensors) {
-    tensor_map[tensor->getGuid()] = tensor;
-    tensor_i_map[tensor->getGuid()] = tensor_i++;
+  // Every operator Kahn's algorithm leaves out has a producer that is left
+  // out too, so walking up producers from one of them ends in a cycle.
+  std::unordered_set<OperatorObj *> done;
+  for (const auto &op : order) {
+    done.insert(op.get());
   }
-
-  // 1. 计划合并两个一组的相邻 transpose
-  for (const auto &[guid, op] : op_map) {
-    if (erased_ops.find(guid) != erased_ops.end()) {
-      continue;
-    }
-
-    if (op->getOpType() != OpType::Transpose) {
-      continue;
+  std::unordered_map<OperatorObj *, size_t> visited;
+  OpVec path;
+  auto op = *std::find_if(ops.begin(), ops.end(), [&](const Operator &o) {
+    return done.count(o.get()) == 0;
+  });
+  while (visited.emplace(op.get(), path.size()).second) {
+    path.emplace_back(op);
+    for (const auto &pred : op->getPredecessors()) {
+      if (done.count(pred.get()) == 0) {
+        op = pred;
+        break;
+      }
     }
+  }
+  // Producers first, starting from the operator the walk ended on.
+  OpVec cycle(path.begin() + visited[op.get()], path.end());
+  std::reverse(cycle.begin(), cycle.end());
+  std::rotate(cycle.begin(), cycle.end() - 1, cycle.end());
+  return cycle;
+}
 
-    auto in = op->getInputs(0);
-    auto out = op->getOutput(0);
-    auto next_op = out->getTargets()[0];
-
-    if (next_op->getOpType() != OpType::Transpose) {
-      continue;
-    }
+string GraphObj::cycleToString() const {
+  std::ostringstream oss;
+  for (const auto &op : findCycle()) {
+    oss << op->getOpType().toString() << "[" << op->getGuid() << "] -> ";
+  }
+  auto ret = oss.str();
+  return ret.empty() ? ret : ret.substr(0, ret.size() - 4);
+}
 
-    // 先解析为 Ref<TransposeObj>
-    auto tr_op = as<TransposeObj>(op);
-    auto next_tr_op = as<TransposeObj>(next_op);
+void GraphObj::optimize() {
+  // Pin the current outputs first: rewrites leave tensors without targets
+  // along the way, which must not turn into outputs.
+  if (outputs.empty()) {
+    outputs = getOutputs();
+  }
+  PatternRewriter rewriter(RewriteRegistry::getInstance().getPatterns());
+  rewriter.run(*this);
+}
 
-    // 只有两次的 permute 相同, 才能合并
-    if (tr_op->getPermute() != next_tr_op->getPermute()) {
-      continue;
+void GraphObj::replaceOpInput(const Operator &op, const Tensor &from,
+                              const Tensor &to) {
+  auto fromSrc = from->getSource();
+  auto toSrc = to->getSource();
+  // The order stays topological if the new producer runs before `op`.
+  if (sorted && toSrc) {
+    sorted = hasOperator(toSrc) && hasOperator(op) &&
+             opSlots.at(toSrc->getGuid()) < opSlots.at(op->getGuid());
+  }
+  from->removeTarget(op);
+  if (fromSrc) {
+    fromSrc->removeSuccessors(op);
+    op->removePredecessors(fromSrc);
+  }
+  for (auto &input : op->inputs) {
+    if (input == from) {
+      input = to;
+      to->addTarget(op);
+      if (toSrc) {
+        toSrc->addSuccessors(op);
+        op->addPredecessors(toSrc);
+      }
+    } else if (fromSrc && input->getSource() == fromSrc) {
+      // `op` still reads another output of the old producer.
+      fromSrc->addSuccessors(op);
+      op->addPredecessors(fromSrc);
     }
-
-    auto next_out = next_op->getOutput(0);
-    auto next_next_op = next_out->getTargets()[0];
-
-    // 根据测试样例, 直接替换 next_next_op.input 为 input
-    op_map[next_next_op->getGuid()]->replaceInput(next_out, in);
-
-    // 直接替换 targets
-    auto in_i = tensor_i_map[in->getGuid()];
-    tensors[in_i]->removeTarget(op);
-    tensors[in_i]->addTarget(next_next_op);
-
-    // 直接修正 pred
-    op_map[next_next_op->getGuid()]->removePredecessors(next_op);
-
-    // 更新计划
-    erased_ops.insert(guid);
-    erased_ops.insert(next_op->getGuid());
-    op_i_map.erase(guid);
-    op_i_map.erase(next_op->getGuid());
-    tensor_i_map.erase(out->getGuid());
-    tensor_i_map.erase(next_out->getGuid());
   }
+}
 
-  // 2. 计划将 transpose 融入到邻接后继 matmul 中
-  for (const auto &[guid, op] : op_map) {
-    if (erased_ops.find(guid) != erased_ops.end()) {
-      continue;
+void GraphObj::replaceAllUses(const Tensor &from, const Tensor &to) {
+  std::unordered_set<OperatorObj *> visited;
+  for (const auto &op : from->getTargets()) {
+    if (visited.insert(op.get()).second) {
+      replaceOpInput(op, from, to);
     }
+  }
+}
 
-    if (op->getOpType() != OpType::Transpose) {
-      continue;
+void GraphObj::eraseOperator(const Operator &op) {
+  for (const auto &input : op->getInputs()) {
+    input->removeTarget(op);
+    if (auto pred = input->getSource()) {
+      pred->removeSuccessors(op);
     }
-
-    auto in = op->getInputs(0);
-    auto out = op->getOutput(0);
-    auto next_op = out->getTargets()[0];
-
-    // 解析为 Ref<TransposeObj>
-    auto curr_tr_op = as<TransposeObj>(op);
-
-    auto curr_perm = curr_tr_op->getPermute();
-    auto is_last_two_dims_swapped =
-        curr_perm.size() >= 2 &&
-        curr_perm[curr_perm.size() - 1] ==
-            static_cast<int>(curr_perm.size() - 2) &&
-        curr_perm[curr_perm.size() - 2] ==
-            static_cast<int>(curr_perm.size() - 1);
-
-    // 只有满足 `最后两维交换` 的条件, 才能继续
-    if (next_op->getOpType() != OpType::MatMul || !is_last_two_dims_swapped) {
-      continue;
+  }
+  for (const auto &output : op->getOutputs()) {
+    if (output->getSource() == op) {
+      output->source.reset();
     }
-
-    // 先解析为 Ref<MatmulObj>
-    auto mul_op = as<MatmulObj>(next_op);
-
-    // 区分 curr_out 是 A 还是 B, 分情况讨论
-    if (out->getGuid() == mul_op->getInputs(0)->getGuid()) {
-      mul_op->setTransA(!mul_op->getTransA());
-    } else {
-      mul_op->setTransB(!mul_op->getTransB());
+    for (const auto &succ : output->getTargets()) {
+      succ->removePredecessors(op);
     }
-
-    // 根据测试样例, 还要把对应的 A / B 直接替换为 curr_in
-    op_map[mul_op->getGuid()]->replaceInput(op->getOutput(0), in);
-
-    // 直接替换 targets
-    auto in_i = tensor_i_map[in->getGuid()];
-    tensors[in_i]->removeTarget(op);
-    tensors[in_i]->addTarget(next_op);
-
-    // 更新 pred
-    op_map[next_op->getGuid()]->removePredecessors(op);
-
-    // 更新计划
-    erased_ops.insert(guid);
-    op_i_map.erase(guid);
-    tensor_i_map.erase(out->getGuid());
   }
+  removeOperator(op);
+}
 
-  // 3. 应用计划
-  TensorVec new_tensors;
-  OpVec new_ops;
-  new_tensors.reserve(op_i_map.size());
-  new_ops.reserve(op_i_map.size());
-  for (const auto &[guid, tensor_i] : tensor_i_map) {
-    new_tensors.emplace_back(std::move(tensors[tensor_i]));
-  }
-  for (const auto &[guid, op_i] : op_i_map) {
-    new_ops.emplace_back(std::move(ops[op_i]));
+void GraphObj::markOutput(const Tensor &tensor) {
+  IT_ASSERT(hasTensor(tensor), "Marked output is not a tensor of the graph");
+  if (std::find(outputs.begin(), outputs.end(), tensor) == outputs.end()) {
+    outputs.emplace_back(tensor);
   }
-  tensors = std::move(new_tensors);
-  ops = std::move(new_ops);
 }
 
-Tensor GraphObj::getTensor(int fuid) const {
-  for (auto tensor : tensors) {
-    if (tensor->getFuid() == fuid) {
-      return tensor;
-    }
-  }
-  return nullptr;
+Tensor GraphObj::getTensor(UidBaseType fuid) const {
+  auto it = tensorSlots.find(fuid);
+  return it == tensorSlots.end() ? nullptr : tensors[it->second];
 }
 
 void GraphObj::shape_infer() {
+  compact();
   for (auto &op : ops) {
     auto ans = op->inferShape();
     IT_ASSERT(ans.has_value());
@@ -271,26 +509,145 @@ void GraphObj::shape_infer() {
 
 void GraphObj::dataMalloc() {
   // topological sorting first
-  IT_ASSERT(topo_sort() == true);
-
-  vector<size_t> tensor_ptr_offsets;
-  tensor_ptr_offsets.reserve(tensors.size());
-  for (auto &tensor : tensors) {
-    auto offset = allocator.alloc(tensor->getBytes());
-    tensor_ptr_offsets.emplace_back(offset);
+  IT_ASSERT(topo_sort(), "Graph has a cycle: " + cycleToString());
+
+  // Simulate the execution: buffers are allocated when their producer runs
+  // and freed after their last reader, so that later tensors reuse them.
+  CompactGraph graph(*this);
+  Liveness liveness(*this, graph);
+  vector<size_t> offsets(graph.numTensors(), 0);
+  for (Index t = 0; t < graph.numTensors(); ++t) {
+    if (graph.getSource(t) == CompactGraph::None) {
+      offsets[t] = allocator.alloc(graph.getBytes(t));
+    }
+  }
+  for (Index op = 0; op < graph.numOperators(); ++op) {
+    for (auto t : liveness.allocated(op)) {
+      offsets[t] = allocator.alloc(graph.getBytes(t));
+    }
+    for (auto t : liveness.released(op)) {
+      allocator.free(offsets[t], graph.getBytes(t));
+    }
+    liveness.run(op);
   }
 
   auto *ptr = static_cast<char *>(allocator.getPtr());
-  for (size_t i = 0; i < tensors.size(); ++i) {
-    auto *tensor_addr = static_cast<void *>(ptr + tensor_ptr_offsets[i]);
-    tensors[i]->setDataBlob(make_ref<BlobObj>(runtime, tensor_addr));
+  vector<Blob> blobs(graph.numTensors());
+  for (Index t = 0; t < graph.numTensors(); ++t) {
+    auto owner = liveness.owner(t);
+    if (!blobs[owner]) {
+      blobs[owner] = make_ref<BlobObj>(runtime, ptr + offsets[owner]);
+    }
+    tensors[t]->setDataBlob(blobs[owner]);
+    tensors[t]->resetView();
+    if (tensors[t]->isConstant()) {
+      tensors[t]->loadConstant();
+    }
+  }
+  // In topological order, so that the input of a view has its layout.
+  for (Index op = 0; op < graph.numOperators(); ++op) {
+    auto outputs = graph.getOutputs(op);
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      if (liveness.isView(outputs[i])) {
+        auto [strides, offset] = graph.getOperator(op)->inferView(i);
+        tensors[outputs[i]]->setView(std::move(strides), offset);
+      }
+    }
+  }
+  for (const auto &op : getOperators()) {
+    runtime->prepareOp(op);
   }
 
   allocator.info();
 }
 
+size_t GraphObj::getPeakLiveBytes() const {
+  IT_ASSERT(sorted, "Operators are not in topological order");
+  CompactGraph graph(*this);
+  Liveness liveness(*this, graph);
+  size_t live = 0;
+  for (Index t = 0; t < graph.numTensors(); ++t) {
+    if (graph.getSource(t) == CompactGraph::None) {
+      live += graph.getBytes(t);
+    }
+  }
+  auto peak = live;
+  for (Index op = 0; op < graph.numOperators(); ++op) {
+    live += liveness.totalBytes(liveness.allocated(op));
+    peak = std::max(peak, live);
+    live -= liveness.totalBytes(liveness.released(op));
+    liveness.run(op);
+  }
+  return peak;
+}
+
+size_t GraphObj::schedule(ScheduleObjective objective) {
+  IT_ASSERT(topo_sort(), "Graph has a cycle: " + cycleToString());
+  CompactGraph graph(*this);
+  Liveness liveness(*this, graph);
+  auto n = static_cast<Index>(graph.numOperators());
+
+  // How much an operator grows the live bytes if it runs next.
+  auto growth = [&](Index op) {
+    return static_cast<int64_t>(liveness.totalBytes(liveness.allocated(op))) -
+           static_cast<int64_t>(liveness.totalBytes(liveness.released(op)));
+  };
+  // 1 + the step its latest producer ran at, or 0 if it has none.
+  vector<size_t> step(n, 0);
+  auto recency = [&](Index op) {
+    size_t ret = 0;
+    for (auto p : graph.getPredecessors(op)) {
+      ret = std::max(ret, step[p]);
+    }
+    return ret;
+  };
+  // Greedy list scheduling, O(V * ready + E). Ties keep the current order.
+  auto better = [&](Index a, Index b) {
+    if (objective == ScheduleObjective::PeakMemory) {
+      auto ga = growth(a);
+      auto gb = growth(b);
+      return ga < gb || (ga == gb && a < b);
+    }
+    auto ra = recency(a);
+    auto rb = recency(b);
+    return ra > rb || (ra == rb && a < b);
+  };
+
+  vector<size_t> inDegree;
+  vector<Index> ready;
+  for (Index op = 0; op < n; ++op) {
+    inDegree.emplace_back(graph.getPredecessors(op).size());
+    if (inDegree.back() == 0) {
+      ready.emplace_back(op);
+    }
+  }
+  OpVec order;
+  order.reserve(n);
+  while (!ready.empty()) {
+    auto best = ready.begin();
+    for (auto it = ready.begin() + 1; it != ready.end(); ++it) {
+      if (better(*it, *best)) {
+        best = it;
+      }
+    }
+    auto op = *best;
+    ready.erase(best);
+    liveness.run(op);
+    order.emplace_back(graph.getOperator(op));
+    step[op] = order.size();
+    for (auto c : graph.getSuccessors(op)) {
+      if (--inDegree[c] == 0) {
+        ready.emplace_back(c);
+      }
+    }
+  }
+  ops = std::move(order);
+  reindexOperators();
+  return getPeakLiveBytes();
+}
+
 Tensor GraphObj::addTensor(const Shape &dim, DataType dtype) {
-  return tensors.emplace_back(make_ref<TensorObj>(dim, dtype, runtime));
+  return addTensor(make_ref<TensorObj>(dim, dtype, runtime));
 }
 
 Tensor GraphObj::addTensor(const Tensor &tensor) {
@@ -298,6 +655,8 @@ Tensor GraphObj::addTensor(const Tensor &tensor) {
             std::string("Tensor runtime mismatch: cannot add a tensor in ") +
                 tensor->getRuntime()->toString() + " to " +
                 runtime->toString());
+  // A duplicate FUID keeps the first slot; checkValid() reports it.
+  tensorSlots.emplace(tensor->getFuid(), tensors.size());
   tensors.emplace_back(tensor);
   return tensor;
 }
@@ -313,31 +672,34 @@ TensorVec GraphObj::addTensor(const TensorVec &tensors) {
 // tensor has no "source" and no "target" must not exist.
 // "inputs" or "outputs" of operators must be in "tensors"
 // "predecessors" and "successors" of an operator of "ops" must be in "ops".
+// marked "outputs" must be in "tensors".
 bool GraphObj::checkValid() const {
+  compact();
   for (const auto &tensor : tensors) {
-    IT_ASSERT(!tensor->getTargets().empty() || nullptr != tensor->getSource());
+    IT_ASSERT(tensor->numTargets() != 0 || tensor->hasSource());
     for (const auto &op : tensor->getTargets()) {
-      IT_ASSERT(std::find(ops.begin(), ops.end(), op) != ops.end());
+      IT_ASSERT(hasOperator(op));
     }
     auto op = tensor->getSource();
-    IT_ASSERT(!(op && std::find(ops.begin(), ops.end(), op) == ops.end()));
+    IT_ASSERT(!(op && !hasOperator(op)));
   }
   for (const auto &op : ops) {
     for (const auto &tensor : op->getInputs()) {
-      IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
-                tensors.end());
+      IT_ASSERT(hasTensor(tensor));
     }
     for (const auto &tensor : op->getOutputs()) {
-      IT_ASSERT(std::find(tensors.begin(), tensors.end(), tensor) !=
-                tensors.end());
+      IT_ASSERT(hasTensor(tensor));
     }
     for (const auto &pre : op->getPredecessors()) {
-      IT_ASSERT(std::find(ops.begin(), ops.end(), pre) != ops.end());
+      IT_ASSERT(hasOperator(pre));
     }
     for (const auto &suc : op->getSuccessors()) {
-      IT_ASSERT(std::find(ops.begin(), ops.end(), suc) != ops.end());
+      IT_ASSERT(hasOperator(suc));
     }
   }
+  for (const auto &tensor : outputs) {
+    IT_ASSERT(hasTensor(tensor));
+  }
   std::set<UidBaseType> s;
   // check whether two tensors with the same FUID exist
   for (const auto &tensor : tensors) {
@@ -19,6 +19,15 @@ const char *OpType::toString() const {
     CASE(Transpose);
     CASE(Concat);
     CASE(MatMul);
+    CASE(FusedElementWise);
+    CASE(Reshape);
+    CASE(Flatten);
+    CASE(Squeeze);
+    CASE(Unsqueeze);
+    CASE(Slice);
+    CASE(Split);
+    CASE(QuantizeLinear);
+    CASE(DequantizeLinear);
 
   default:
     return "Unknown";
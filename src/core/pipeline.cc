@@ -0,0 +1,181 @@
+#include "core/pipeline.h"
+#include "operators/matmul.h"
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace infini {
+
+namespace {
+// Rough amount of work of an operator, used to balance the stages.
+size_t estimateCost(const Operator &op) {
+  if (op->getOpType() == OpType::MatMul) {
+    // MatmulObj names the reduced dimension `n`.
+    auto matmul = as<MatmulObj>(op);
+    return op->getOutput()->size() * std::max(matmul->getN(), 1);
+  }
+  size_t cost = 0;
+  for (const auto &t : op->getInputs()) {
+    cost += t->size();
+  }
+  for (const auto &t : op->getOutputs()) {
+    cost += t->size();
+  }
+  return cost;
+}
+} // namespace
+
+PipelineExecutor::PipelineExecutor(const Graph &graph, PipelineConfig config)
+    : runtime(graph->getRuntime()), config(config) {
+  IT_ASSERT(graph->topo_sort(), "Cannot pipeline a graph with cycles");
+  const auto &ops = graph->getOperators();
+  IT_ASSERT(!ops.empty());
+  IT_ASSERT(config.nStages > 0);
+  partition(ops);
+
+  auto nBuffers = config.nBuffers != 0 ? config.nBuffers : numStages();
+  auto inputs = graph->getInputs();
+  auto outputs = graph->getOutputs();
+  for (size_t i = 0; i < nBuffers; ++i) {
+    auto buffer = make_ref<GraphObj>(runtime, ops);
+    // The clone lists its operators in the order of `ops`.
+    vector<OpVec> slotOps;
+    for (size_t stage = 0; stage < numStages(); ++stage) {
+      slotOps.emplace_back(
+          buffer->getOperators().begin() + stageBegin[stage],
+          buffer->getOperators().begin() + stageBegin[stage + 1]);
+    }
+    stageOps.emplace_back(std::move(slotOps));
+    // Mark the outputs before planning the memory, so that outputs that are
+    // also consumed keep their buffers.
+    TensorVec bufOutputs;
+    for (const auto &t : outputs) {
+      auto clone = buffer->getTensor(t->getFuid());
+      buffer->markOutput(clone);
+      bufOutputs.emplace_back(clone);
+    }
+    buffer->dataMalloc();
+    TensorVec bufInputs;
+    for (const auto &t : inputs) {
+      auto clone = buffer->getTensor(t->getFuid());
+      if (t->hasData()) {
+        std::memcpy(clone->getRawDataPtr<void *>(),
+                    t->getRawDataPtr<void *>(), t->getBytes());
+      }
+      bufInputs.emplace_back(clone);
+    }
+    buffers.emplace_back(std::move(buffer));
+    bufferInputs.emplace_back(std::move(bufInputs));
+    bufferOutputs.emplace_back(std::move(bufOutputs));
+  }
+}
+
+void PipelineExecutor::partition(const OpVec &ops) {
+  auto nStages = std::min(config.nStages, ops.size());
+  size_t total = 0;
+  for (const auto &op : ops) {
+    total += estimateCost(op);
+  }
+  stageBegin = {0};
+  size_t acc = 0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    acc += estimateCost(ops[i]);
+    auto stage = stageBegin.size();
+    if (stage == nStages) {
+      break;
+    }
+    auto remainingOps = ops.size() - i - 1;
+    auto remainingStages = nStages - stage;
+    if (remainingOps == remainingStages ||
+        (acc * nStages >= total * stage && remainingOps > remainingStages)) {
+      stageBegin.emplace_back(i + 1);
+    }
+  }
+  stageBegin.emplace_back(ops.size());
+}
+
+OpVec PipelineExecutor::getStage(size_t stage) const {
+  IT_ASSERT(stage < numStages());
+  return stageOps[0][stage];
+}
+
+void PipelineExecutor::run(size_t nBatches, const Feeder &feed,
+                           const Consumer &consume) {
+  auto nStages = numStages();
+  auto nBuffers = buffers.size();
+
+  // done[s] is the number of micro-batches stage `s` has finished.
+  vector<size_t> done(nStages, 0);
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr error;
+
+  auto worker = [&](size_t stage) {
+#ifdef _OPENMP
+    if (config.threadsPerStage > 0) {
+      omp_set_num_threads(config.threadsPerStage);
+    }
+#endif
+    for (size_t b = 0; b < nBatches; ++b) {
+      {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] {
+          if (error) {
+            return true;
+          }
+          if (stage > 0) {
+            return done[stage - 1] > b;
+          }
+          // The buffer set is free once micro-batch `b - nBuffers` left the
+          // last stage.
+          return done[nStages - 1] + nBuffers > b;
+        });
+        if (error) {
+          return;
+        }
+      }
+      try {
+        auto slot = b % nBuffers;
+        if (stage == 0) {
+          feed(b, bufferInputs[slot]);
+        }
+        for (const auto &op : stageOps[slot][stage]) {
+          runtime->runOp(op);
+        }
+        if (stage == nStages - 1) {
+          consume(b, bufferOutputs[slot]);
+        }
+      } catch (...) {
+        std::lock_guard lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        cv.notify_all();
+        return;
+      }
+      {
+        std::lock_guard lock(mutex);
+        ++done[stage];
+      }
+      cv.notify_all();
+    }
+  };
+
+  vector<std::thread> threads;
+  threads.reserve(nStages);
+  for (size_t stage = 0; stage < nStages; ++stage) {
+    threads.emplace_back(worker, stage);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace infini
@@ -0,0 +1,161 @@
+#include "core/rewriter.h"
+#include <deque>
+#include <unordered_set>
+
+namespace infini {
+
+namespace {
+// Rewrites erase operators the worklist may still hold.
+bool isAlive(const Operator &op) {
+  const auto &outputs = op->getOutputs();
+  return !outputs.empty() && outputs[0]->getSource() == op;
+}
+} // namespace
+
+PatternRewriter::PatternRewriter(vector<RewritePattern> patterns,
+                                 size_t maxRewrites)
+    : maxRewrites(maxRewrites) {
+  for (auto &pattern : patterns) {
+    add(std::move(pattern));
+  }
+}
+
+void PatternRewriter::add(RewritePattern pattern) {
+  IT_ASSERT(!pattern.chain.empty() && pattern.rewrite,
+            "Invalid rewrite pattern " + pattern.name);
+  // Patterns of the same priority keep the order they were added in.
+  auto it = std::upper_bound(
+      patterns.begin(), patterns.end(), pattern.priority,
+      [](int priority, const RewritePattern &p) {
+        return priority > p.priority;
+      });
+  patterns.insert(it, std::move(pattern));
+}
+
+size_t PatternRewriter::run(GraphObj &graph) const {
+  size_t total = 0;
+  auto changed = true;
+  while (changed && total < maxRewrites) {
+    changed = false;
+    // Restart from the highest priority whenever a lower one changes the
+    // graph, so that new opportunities are taken in priority order.
+    for (size_t begin = 0; begin < patterns.size();) {
+      auto end = begin;
+      while (end < patterns.size() &&
+             patterns[end].priority == patterns[begin].priority) {
+        ++end;
+      }
+      auto applied = runLevel(graph, begin, end, maxRewrites - total);
+      total += applied;
+      if (applied > 0 && begin > 0) {
+        changed = true;
+        break;
+      }
+      begin = end;
+    }
+  }
+  return total;
+}
+
+size_t PatternRewriter::runLevel(GraphObj &graph, size_t begin, size_t end,
+                                 size_t budget) const {
+  // Seeding in topological order matches chains from their head first.
+  graph.topo_sort();
+  std::deque<Operator> worklist;
+  std::unordered_set<OperatorObj *> queued;
+  auto push = [&](const Operator &op) {
+    if (op && queued.insert(op.get()).second) {
+      worklist.emplace_back(op);
+    }
+  };
+  for (const auto &op : graph.getOperators()) {
+    push(op);
+  }
+
+  size_t applied = 0;
+  while (!worklist.empty() && applied < budget) {
+    auto op = std::move(worklist.front());
+    worklist.pop_front();
+    queued.erase(op.get());
+    if (!isAlive(op)) {
+      continue;
+    }
+    for (auto i = begin; i < end; ++i) {
+      const auto &pattern = patterns[i];
+      TensorVec boundary;
+      OpVec ops{op};
+      auto fired = match(graph, pattern, ops, [&](const OpVec &matched) {
+        TensorVec tensors;
+        for (const auto &m : matched) {
+          for (const auto &t : m->getInputs()) {
+            tensors.emplace_back(t);
+          }
+          for (const auto &t : m->getOutputs()) {
+            tensors.emplace_back(t);
+          }
+        }
+        if (!pattern.rewrite(graph, matched)) {
+          return false;
+        }
+        boundary = std::move(tensors);
+        return true;
+      });
+      if (!fired) {
+        continue;
+      }
+      ++applied;
+      // New matches can only involve operators next to the rewritten region,
+      // including the ones the rewrite created.
+      push(op);
+      for (const auto &t : boundary) {
+        push(t->getSource());
+        for (const auto &target : t->getTargets()) {
+          push(target);
+        }
+      }
+      break;
+    }
+  }
+  return applied;
+}
+
+bool PatternRewriter::match(
+    const GraphObj &graph, const RewritePattern &pattern, OpVec &ops,
+    const std::function<bool(const OpVec &)> &onMatch) const {
+  auto expected = pattern.chain[ops.size() - 1];
+  if (expected != OpType::Unknown && ops.back()->getOpType() != expected) {
+    return false;
+  }
+  if (ops.size() == pattern.chain.size()) {
+    return onMatch(ops);
+  }
+  std::unordered_set<OperatorObj *> visited;
+  for (const auto &output : ops.back()->getOutputs()) {
+    if (pattern.singleUse &&
+        (output->numTargets() != 1 || graph.isOutput(output))) {
+      continue;
+    }
+    for (const auto &next : output->getTargets()) {
+      if (!visited.insert(next.get()).second) {
+        continue;
+      }
+      ops.emplace_back(next);
+      if (match(graph, pattern, ops, onMatch)) {
+        return true;
+      }
+      ops.pop_back();
+    }
+  }
+  return false;
+}
+
+bool RewriteRegistry::registerPattern(RewritePattern pattern) {
+  for (const auto &p : patterns) {
+    IT_ASSERT(p.name != pattern.name,
+              "Rewrite pattern " + pattern.name + " registered twice");
+  }
+  patterns.emplace_back(std::move(pattern));
+  return true;
+}
+
+} // namespace infini
@@ -1,17 +1,93 @@
 #include "core/runtime.h"
 #include "core/graph.h"
 #include "core/kernel.h"
+#include "utils/thread_pool.h"
 #include <cstring>
+#include <thread>
 
 namespace infini {
 
-void NativeCpuRuntimeObj::run(const Graph &graph) const {
-  const auto &kernelRegistry = KernelRegistry::getInstance();
+void RuntimeObj::checkRunOptions(const RunOptions &options) {
+  IT_ASSERT(!(options.cancel && options.cancel->isCancelled()),
+            "Run cancelled");
+  IT_ASSERT(!(options.deadline &&
+              std::chrono::steady_clock::now() > *options.deadline),
+            "Run deadline exceeded");
+}
+
+void RuntimeObj::submitToWorkers(std::function<void()> task) const {
+  // Submit under the lock: setWorkerThreads() may otherwise free the pool
+  // in between.
+  std::lock_guard lock(workersMutex);
+  if (!workers) {
+    auto n = nWorkers != 0 ? nWorkers : std::thread::hardware_concurrency();
+    workers = make_ref<ThreadPool>(std::max<size_t>(n, 1));
+  }
+  workers->submit(std::move(task));
+}
 
+void RuntimeObj::setWorkerThreads(size_t n) {
+  Ref<ThreadPool> old;
+  {
+    std::lock_guard lock(workersMutex);
+    nWorkers = n;
+    old = std::move(workers);
+  }
+  // Destroying the old pool waits for its queue, so do it unlocked: the
+  // queued runs may start runs of their own on the new pool.
+  old.reset();
+}
+
+std::future<void> RuntimeObj::runAsync(const Graph &graph, RunOptions options,
+                                       RunCallback callback) const {
+  auto promise = std::make_shared<std::promise<void>>();
+  auto future = promise->get_future();
+  // Keep the runtime alive until the task has finished.
+  submitToWorkers([self = shared_from_this(), graph,
+                   options = std::move(options),
+                   callback = std::move(callback), promise] {
+    std::exception_ptr error;
+    try {
+      self->run(graph, options);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    if (callback) {
+      try {
+        callback(error);
+      } catch (...) {
+        error = error ? error : std::current_exception();
+      }
+    }
+    if (error) {
+      promise->set_exception(error);
+    } else {
+      promise->set_value();
+    }
+  });
+  return future;
+}
+
+void NativeCpuRuntimeObj::run(const Graph &graph,
+                              const RunOptions &options) const {
   for (const auto &op : graph->getOperators()) {
-    auto kernelAttrs = KernelAttrs{device, op->getOpType().underlying()};
-    Kernel *kernel = kernelRegistry.getKernel(kernelAttrs);
-    kernel->compute(op, this);
+    checkRunOptions(options);
+    runOp(op);
+  }
+}
+
+void NativeCpuRuntimeObj::runOp(const Operator &op) const {
+  const auto &kernelRegistry = KernelRegistry::getInstance();
+  auto kernelAttrs = KernelAttrs{device, op->getOpType().underlying()};
+  Kernel *kernel = kernelRegistry.getKernel(kernelAttrs);
+  kernel->compute(op, this);
+}
+
+void NativeCpuRuntimeObj::prepareOp(const Operator &op) const {
+  const auto &kernelRegistry = KernelRegistry::getInstance();
+  auto kernelAttrs = KernelAttrs{device, op->getOpType().underlying()};
+  if (kernelRegistry.hasKernel(kernelAttrs)) {
+    kernelRegistry.getKernel(kernelAttrs)->prepare(op, this);
   }
 }
 
@@ -2,6 +2,7 @@
 #include "core/blob.h"
 #include "core/operator.h"
 #include "core/runtime.h"
+#include <atomic>
 #include <cstring>
 #include <numeric>
 #include <utility>
@@ -11,8 +12,9 @@ namespace infini {
 TensorObj::TensorObj(Shape shape_, DataType dtype, Runtime runtime)
     : dim(static_cast<int>(shape_.size())), dtype(dtype),
       runtime(std::move(runtime)), shape(std::move(shape_)),
-      _size(std::accumulate(shape.begin(), shape.end(), 1, std::multiplies{})) {
-}
+      _size(std::accumulate(shape.begin(), shape.end(), size_t{1},
+                            std::multiplies{})),
+      strides(contiguousStrides(shape)) {}
 
 string TensorObj::toString() const {
   // Convert data pointer to string
@@ -42,9 +44,42 @@ string TensorObj::toString() const {
 
 void TensorObj::setShape(Shape shape_) {
   shape = std::move(shape_);
-  size_t size = std::accumulate(shape.begin(), shape.end(), 1,
-                                [](auto acc, auto x) { return acc * x; });
-  _size = size;
+  _size = std::accumulate(shape.begin(), shape.end(), size_t{1},
+                          std::multiplies{});
+  resetView();
+}
+
+Strides TensorObj::contiguousStrides(const Shape &shape) {
+  Strides ret(shape.size());
+  int64_t p = 1;
+  for (auto i = shape.size(); i > 0; --i) {
+    ret[i - 1] = p;
+    p *= shape[i - 1];
+  }
+  return ret;
+}
+
+bool TensorObj::isContiguous() const {
+  int64_t p = 1;
+  for (auto i = shape.size(); i > 0; --i) {
+    // The stride of a dimension of size 1 is never used.
+    if (shape[i - 1] != 1 && strides[i - 1] != p) {
+      return false;
+    }
+    p *= shape[i - 1];
+  }
+  return true;
+}
+
+void TensorObj::setView(Strides strides_, size_t offset_) {
+  IT_ASSERT(strides_.size() == shape.size());
+  strides = std::move(strides_);
+  offset = offset_;
+}
+
+void TensorObj::resetView() {
+  strides = contiguousStrides(shape);
+  offset = 0;
 }
 
 void TensorObj::printData() const {
@@ -114,11 +149,40 @@ bool TensorObj::equalData(const Tensor &rhs, double relativeError) const {
 }
 
 void TensorObj::setData(
-    const std::function<void(void *, size_t, DataType)> &generator) const {
+    const std::function<void(void *, size_t, DataType)> &generator) {
   IT_ASSERT(data != nullptr);
   generator(getRawDataPtr<void *>(), size(), dtype);
+  touchData();
 }
 
-void TensorObj::setDataBlob(const Blob &blob) { this->data = blob; }
+void TensorObj::setDataBlob(const Blob &blob) {
+  this->data = blob;
+  touchData();
+}
+
+void TensorObj::touchData() {
+  static std::atomic<uint64_t> counter{0};
+  dataVersion = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void TensorObj::setConstant(
+    const std::function<void(void *, size_t, DataType)> &generator) {
+  constant = make_ref<vector<uint8_t>>(getBytes());
+  if (generator) {
+    generator(constant->data(), size(), dtype);
+  }
+}
+
+Blob TensorObj::getConstantBlob() const {
+  IT_ASSERT(constant != nullptr);
+  return make_ref<BlobObj>(runtime, constant->data());
+}
+
+void TensorObj::loadConstant() {
+  IT_ASSERT(constant != nullptr && data != nullptr);
+  IT_ASSERT(runtime->isCpu());
+  std::memcpy(getRawDataPtr<void *>(), constant->data(), getBytes());
+  touchData();
+}
 
 }; // namespace infini
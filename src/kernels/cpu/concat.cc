@@ -1,63 +1,25 @@
 #include "operators/concat.h"
 #include "core/kernel.h"
+#include "utils/operator_utils.h"
 
 namespace infini {
 
+// Copies each input into its range of the output, in memcpy runs as long as
+// the input is contiguous below the concatenated dimension.
 class NaiveConcat : public CpuKernelWithoutConfig {
-  template <typename T>
-  void doCompute(const Operator &_op, const RuntimeObj *context) const {
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
     auto op = as<ConcatObj>(_op);
-    auto inputs = op->getInputs();
-    auto outputs = op->getOutputs();
+    const auto &output = op->getOutput();
     auto dim = op->getDim();
-    const auto &output = outputs[0];
-    std::vector<Shape> iDims;
-    for (const auto &input : inputs) {
-      iDims.emplace_back(input->getDims());
-    }
-    const auto &outDim = output->getDims();
-    size_t blockOffsetInner = 1;
-    for (size_t i = outDim.size() - 1; i > static_cast<size_t>(dim); --i) {
-      blockOffsetInner *= outDim[i];
-    }
-    size_t blockOffset = outDim[dim] * blockOffsetInner;
-    for (size_t i = 0; i < inputs.size(); ++i) {
-      const auto &input = inputs[i];
-      auto dimOffset = 0;
-      const auto &iDim = iDims[i];
-      for (size_t j = 0; j < i; ++j) {
-        dimOffset += iDims[j][dim];
-      }
-      size_t localBlockOffset = 1;
-      for (size_t k = iDim.size() - 1;
-           k >= static_cast<size_t>(dim) && k != static_cast<size_t>(-1); --k) {
-        localBlockOffset *= iDim[k];
-      }
-      auto innerOffset = blockOffsetInner * dimOffset;
-      auto inSize = input->size();
-      auto *inPtr = input->getRawDataPtr<T *>();
-      auto *outPtr = output->getRawDataPtr<T *>();
-#pragma omp parallel for
-      for (size_t iOffset = 0; iOffset < inSize; ++iOffset) {
-        auto oOffset = (iOffset % localBlockOffset) + innerOffset +
-                       (iOffset / localBlockOffset * blockOffset);
-        outPtr[oOffset] = inPtr[iOffset];
-      }
-    }
-  }
-
-  void compute(const Operator &_op, const RuntimeObj *context) const override {
-#define CASE(N)                                                                \
-  case N:                                                                      \
-    doCompute<DT<N>::t>(_op, context)
-
-    switch (_op->getDType().getIndex()) {
-      CASE(1); // DataType::Float32
-      break;
-      CASE(12); // DataType::UInt32
-      break;
-    default:
-      IT_TODO_HALT();
+    const auto &outStrides = output->getStrides();
+    auto elemSize = output->getDType().getSize();
+    auto *outPtr = output->getRawDataPtr<uint8_t *>();
+    int64_t dimOffset = 0;
+    for (const auto &input : op->getInputs()) {
+      copy_strided(outPtr + dimOffset * outStrides[dim] * elemSize, outStrides,
+                   input->getRawDataPtr<uint8_t *>(), input->getStrides(),
+                   input->getDims(), elemSize);
+      dimOffset += input->getDims()[dim];
     }
   }
 };
@@ -28,9 +28,9 @@ class NativeElementWise : public CpuKernelWithoutConfig {
     T *inptr1 = op->getInputs(1)->getRawDataPtr<T *>();
     T *outptr = op->getOutput()->getRawDataPtr<T *>();
 
-    auto shapeA = op->getInputs(0)->getDims();
-    auto shapeB = op->getInputs(1)->getDims();
-    auto shapeC = op->getOutput()->getDims();
+    const auto &shapeA = op->getInputs(0)->getDims();
+    const auto &shapeB = op->getInputs(1)->getDims();
+    const auto &shapeC = op->getOutput()->getDims();
     auto rank = op->getOutput()->getRank();
     Shape a(rank, 1);
     Shape b(rank, 1);
@@ -38,17 +38,9 @@ class NativeElementWise : public CpuKernelWithoutConfig {
               a.begin() + static_cast<long>(rank - shapeA.size()));
     std::copy(shapeB.begin(), shapeB.end(),
               b.begin() + static_cast<long>(rank - shapeB.size()));
-    auto getStride = [&](const Shape &shape) {
-      int p = 1;
-      Shape stride(rank);
-      for (auto i = rank; i > 0; --i) {
-        stride[i - 1] = p;
-        p = p * shape[i - 1];
-      }
-      return stride;
-    };
-    Shape strideA = getStride(a);
-    Shape strideB = getStride(b);
+    // The inputs may be views.
+    Strides strideA = broadcast_strides(op->getInputs(0), rank);
+    Strides strideB = broadcast_strides(op->getInputs(1), rank);
 
     auto n = op->getOutput()->size();
     T (*_doCompute)(T val0, T val1){nullptr};
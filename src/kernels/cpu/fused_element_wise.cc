@@ -0,0 +1,163 @@
+#include "operators/fused_element_wise.h"
+#include "core/kernel.h"
+#include "utils/operator_utils.h"
+
+namespace infini {
+
+class NativeFusedElementWise : public CpuKernelWithoutConfig {
+  // Elements of the innermost dimension evaluated together. Small enough to
+  // keep the running values in L1, large enough for the loops to vectorize.
+  static constexpr size_t TILE = 256;
+
+  template <typename T, typename F>
+  static void binaryLoop(T *acc, const T *x, int64_t stride, size_t n, F f) {
+    if (stride == 1) {
+      for (size_t i = 0; i < n; ++i) {
+        acc[i] = f(acc[i], x[i]);
+      }
+    } else if (stride == 0) {
+      auto val = *x;
+      for (size_t i = 0; i < n; ++i) {
+        acc[i] = f(acc[i], val);
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        acc[i] = f(acc[i], x[i * stride]);
+      }
+    }
+  }
+
+  template <typename T>
+  static void binaryStep(const FusedStep &step, T *acc, const T *x,
+                         int64_t stride, size_t n) {
+    auto first = step.operandFirst;
+    switch (step.type.underlying()) {
+    case OpType::Add:
+      binaryLoop(acc, x, stride, n, [](T a, T b) { return a + b; });
+      break;
+    case OpType::Sub:
+      if (first) {
+        binaryLoop(acc, x, stride, n, [](T a, T b) { return b - a; });
+      } else {
+        binaryLoop(acc, x, stride, n, [](T a, T b) { return a - b; });
+      }
+      break;
+    case OpType::Mul:
+      binaryLoop(acc, x, stride, n, [](T a, T b) { return a * b; });
+      break;
+    case OpType::Div:
+      if (first) {
+        binaryLoop(acc, x, stride, n,
+                   [](T a, T b) { return static_cast<T>(b / a); });
+      } else {
+        binaryLoop(acc, x, stride, n,
+                   [](T a, T b) { return static_cast<T>(a / b); });
+      }
+      break;
+    default:
+      IT_TODO_HALT();
+    }
+  }
+
+  template <typename T>
+  static void unaryStep(const FusedStep &step, T *acc, size_t n) {
+    switch (step.type.underlying()) {
+    case OpType::Relu:
+      for (size_t i = 0; i < n; ++i) {
+        acc[i] = std::max(T(0), acc[i]);
+      }
+      break;
+    case OpType::Clip:
+      for (size_t i = 0; i < n; ++i) {
+        auto val = acc[i];
+        if (step.min && val < *step.min) {
+          acc[i] = *step.min;
+        } else if (step.max && val > *step.max) {
+          acc[i] = *step.max;
+        }
+      }
+      break;
+    default:
+      IT_TODO_HALT();
+    }
+  }
+
+  template <typename T>
+  void doCompute(const Operator &_op, const RuntimeObj *context) const {
+    auto op = as<FusedElementWiseObj>(_op);
+    const auto &steps = op->getSteps();
+    const auto &outDim = op->getOutput()->getDims();
+    auto rank = outDim.size();
+    auto nInputs = op->getInputs().size();
+
+    // Element strides of every input in the output index space, 0 along
+    // broadcast dimensions. The inputs may be views.
+    vector<const T *> inPtrs(nInputs);
+    vector<Strides> strides;
+    for (size_t k = 0; k < nInputs; ++k) {
+      const auto &input = op->getInputs(k);
+      inPtrs[k] = input->getRawDataPtr<T *>();
+      strides.emplace_back(broadcast_strides(input, rank));
+    }
+
+    T *outPtr = op->getOutput()->getRawDataPtr<T *>();
+    size_t inner = rank == 0 ? 1 : outDim[rank - 1];
+    size_t outer = inner == 0 ? 0 : op->getOutput()->size() / inner;
+
+#pragma omp parallel for
+    for (size_t o = 0; o < outer; ++o) {
+      T acc[TILE];
+      vector<int64_t> base(nInputs, 0);
+      auto rest = o;
+      for (size_t d = rank > 0 ? rank - 1 : 0; d > 0; --d) {
+        auto idx = static_cast<int64_t>(rest % outDim[d - 1]);
+        rest /= outDim[d - 1];
+        for (size_t k = 0; k < nInputs; ++k) {
+          base[k] += idx * strides[k][d - 1];
+        }
+      }
+      for (size_t j0 = 0; j0 < inner; j0 += TILE) {
+        auto n = std::min(TILE, inner - j0);
+        auto innerOffset = static_cast<int64_t>(j0);
+        auto at = [&](size_t k) {
+          auto stride = rank == 0 ? 0 : strides[k][rank - 1];
+          return inPtrs[k] + base[k] + innerOffset * stride;
+        };
+        auto stride0 = rank == 0 ? 0 : strides[0][rank - 1];
+        const T *in0 = at(0);
+        for (size_t i = 0; i < n; ++i) {
+          acc[i] = in0[i * stride0];
+        }
+        for (const auto &step : steps) {
+          if (step.operand >= 0) {
+            auto stride = rank == 0 ? 0 : strides[step.operand][rank - 1];
+            binaryStep(step, acc, at(step.operand), stride, n);
+          } else {
+            unaryStep(step, acc, n);
+          }
+        }
+        std::copy(acc, acc + n, outPtr + o * inner + j0);
+      }
+    }
+  }
+
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
+#define CASE(N)                                                                \
+  case N:                                                                      \
+    doCompute<DT<N>::t>(_op, context)
+
+    switch (_op->getDType().getIndex()) {
+      CASE(1); // DataType::Float32
+      break;
+      CASE(12); // DataType::UInt32
+      break;
+    default:
+      IT_TODO_HALT();
+    }
+  }
+};
+
+REGISTER_KERNEL(Device::CPU, OpType::FusedElementWise, NativeFusedElementWise,
+                "FusedElementWise_CPU");
+
+}; // namespace infini
@@ -0,0 +1,389 @@
+#include "operators/matmul.h"
+#include "core/kernel.h"
+#include "utils/operator_utils.h"
+#include <algorithm>
+#include <cstring>
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+namespace infini {
+
+namespace {
+// Output columns of an Int8 panel: one 512-bit register of Int32 sums.
+constexpr size_t INT8_PANEL = 16;
+
+size_t roundUp(size_t n, size_t m) { return (n + m - 1) / m * m; }
+
+bool isPackedFor(const MatmulPackedB &packed, const Tensor &b, size_t panel,
+                 bool transB) {
+  return packed.fuid == b->getFuid() &&
+         packed.version == b->getDataVersion() && packed.panel == panel &&
+         packed.transB == transB;
+}
+
+void setPackedFor(MatmulPackedB &packed, const Tensor &b, size_t panel,
+                  bool transB) {
+  packed.fuid = b->getFuid();
+  packed.version = b->getDataVersion();
+  packed.panel = panel;
+  packed.transB = transB;
+}
+
+// Packs an Int8 B into panels of INT8_PANEL columns. In a panel, every group
+// of 4 rows stores the 4 elements of each column next to each other, the
+// operand layout of VNNI's vpdpbusd. Rows and columns are padded with zeros to
+// whole groups and panels.
+void packInt8(const int8_t *src, int64_t bP, int64_t bJ, size_t K, size_t N,
+              MatmulPackedB &packed) {
+  auto K4 = roundUp(K, 4);
+  auto N16 = roundUp(N, INT8_PANEL);
+  packed.data.assign(K4 * N16, 0);
+  packed.colSums.assign(N16, 0);
+  auto *dst = reinterpret_cast<int8_t *>(packed.data.data());
+  for (size_t j = 0; j < N; ++j) {
+    auto *panel = dst + j / INT8_PANEL * INT8_PANEL * K4;
+    auto lane = j % INT8_PANEL;
+    const int8_t *col = src + static_cast<int64_t>(j) * bJ;
+    for (size_t p = 0; p < K; ++p) {
+      auto val = col[static_cast<int64_t>(p) * bP];
+      panel[p / 4 * 4 * INT8_PANEL + lane * 4 + p % 4] = val;
+      packed.colSums[j] += 128 * val;
+    }
+  }
+}
+
+// One row of an Int8 product: `out[j] = sum(a[p] * B[p][j])` over the K4
+// entries of `a`, padded with zeros like B.
+void int8Row(const int8_t *a, const MatmulPackedB &packed, size_t K4,
+             size_t N, int32_t *out) {
+  const auto *b = reinterpret_cast<const int8_t *>(packed.data.data());
+  for (size_t j0 = 0; j0 < N; j0 += INT8_PANEL) {
+    const int8_t *panel = b + j0 * K4;
+    int32_t acc[INT8_PANEL] = {};
+    for (size_t p = 0; p < K4; p += 4) {
+      const int8_t *group = panel + p * INT8_PANEL;
+      for (size_t lane = 0; lane < INT8_PANEL; ++lane) {
+        for (size_t q = 0; q < 4; ++q) {
+          acc[lane] += a[p + q] * group[lane * 4 + q];
+        }
+      }
+    }
+    auto n = std::min(INT8_PANEL, N - j0);
+    std::copy(acc, acc + n, out + j0);
+  }
+}
+
+#ifdef __x86_64__
+// int8Row with VNNI. vpdpbusd multiplies unsigned bytes by signed ones, so A
+// is biased by 128 into unsigned bytes and 128 times the column sums of B,
+// kept by packInt8, are subtracted after.
+__attribute__((target("avx512f,avx512vnni"))) void
+int8RowVnni(const int8_t *a, const MatmulPackedB &packed, size_t K4, size_t N,
+            int32_t *out) {
+  const auto *b = reinterpret_cast<const int8_t *>(packed.data.data());
+  for (size_t j0 = 0; j0 < N; j0 += INT8_PANEL) {
+    const int8_t *panel = b + j0 * K4;
+    auto acc = _mm512_setzero_si512();
+    for (size_t p = 0; p < K4; p += 4) {
+      uint32_t group;
+      std::memcpy(&group, a + p, sizeof(group));
+      auto biased = _mm512_set1_epi32(static_cast<int>(group ^ 0x80808080U));
+      acc = _mm512_dpbusd_epi32(acc, biased,
+                                _mm512_loadu_si512(panel + p * INT8_PANEL));
+    }
+    acc = _mm512_sub_epi32(acc,
+                           _mm512_loadu_si512(packed.colSums.data() + j0));
+    auto n = std::min(INT8_PANEL, N - j0);
+    _mm512_mask_storeu_epi32(out + j0, static_cast<__mmask16>((1U << n) - 1),
+                             acc);
+  }
+}
+
+bool hasVnni() {
+  static const bool ret = __builtin_cpu_supports("avx512vnni");
+  return ret;
+}
+#endif
+} // namespace
+
+class NaiveMatmul : public CpuKernelWithoutConfig {
+  // Output columns computed together. The accumulators of a tile stay in L1
+  // while the epilogue is applied to them.
+  static constexpr size_t TILE = 256;
+
+  // A constant B packed into panels of TILE columns: the panel of columns
+  // [j0, j0 + n) holds K rows of n elements, so that the tile loop streams it
+  // whatever the layout of B. Cached on the operator until B is rewritten;
+  // nullptr if B is no constant or is batched.
+  template <typename T> static const T *packedB(const MatmulObj &op) {
+    const auto &b = op.getInputs(1);
+    if (!b->isConstant() || !b->hasData()) {
+      return nullptr;
+    }
+    auto rank = op.getOutput()->getRank();
+    auto bStrides = broadcast_strides(b, rank);
+    if (std::any_of(bStrides.begin(), bStrides.end() - 2,
+                    [](int64_t s) { return s != 0; })) {
+      return nullptr;
+    }
+    auto transB = op.getTransB();
+    size_t K = op.getN();
+    size_t N = op.getK();
+    auto &cache = op.getPackedB();
+    if (!isPackedFor(cache, b, TILE, transB)) {
+      auto bP = bStrides[rank - (transB ? 1 : 2)];
+      auto bJ = bStrides[rank - (transB ? 2 : 1)];
+      cache.data.resize(K * N * sizeof(T));
+      auto *dst = reinterpret_cast<T *>(cache.data.data());
+      const T *src = b->getRawDataPtr<T *>();
+      for (size_t j0 = 0; j0 < N; j0 += TILE) {
+        auto n = std::min(TILE, N - j0);
+        for (size_t p = 0; p < K; ++p) {
+          const T *row = src + static_cast<int64_t>(p) * bP;
+          for (size_t j = j0; j < j0 + n; ++j) {
+            *dst++ = row[static_cast<int64_t>(j) * bJ];
+          }
+        }
+      }
+      setPackedFor(cache, b, TILE, transB);
+    }
+    return cache.data.empty()
+               ? nullptr
+               : reinterpret_cast<const T *>(cache.data.data());
+  }
+
+  template <typename T>
+  void doCompute(const Operator &_op, const RuntimeObj *context) const {
+    auto op = as<MatmulObj>(_op);
+    auto transA = op->getTransA();
+    auto transB = op->getTransB();
+    auto bias = op->getBias();
+    const auto &epilogue = op->getEpilogue();
+    auto alpha = static_cast<T>(epilogue.alpha);
+    auto beta = static_cast<T>(epilogue.beta);
+    // MatmulObj names the reduced dimension `n` and the output columns `k`.
+    size_t M = op->getM();
+    size_t K = op->getN();
+    size_t N = op->getK();
+    if (M == 0 || N == 0) {
+      return;
+    }
+
+    const auto &outDim = op->getOutput()->getDims();
+    auto rank = outDim.size();
+    auto batchRank = rank - 2;
+    // Element strides in the output index space, 0 along broadcast
+    // dimensions. A and B may be views, e.g. of a Transpose.
+    auto aStrides = broadcast_strides(op->getInputs(0), rank);
+    auto bStrides = broadcast_strides(op->getInputs(1), rank);
+    // Strides along the rows and the reduced dimension of A, and along the
+    // reduced dimension and the columns of B.
+    auto aI = aStrides[rank - (transA ? 1 : 2)];
+    auto aP = aStrides[rank - (transA ? 2 : 1)];
+    auto bP = bStrides[rank - (transB ? 1 : 2)];
+    auto bJ = bStrides[rank - (transB ? 2 : 1)];
+    Strides biasStrides;
+    const T *biasPtr = nullptr;
+    if (bias) {
+      biasStrides = broadcast_strides(bias, rank);
+      biasPtr = bias->getRawDataPtr<T *>();
+    }
+
+    const T *aPtr = op->getInputs(0)->getRawDataPtr<T *>();
+    const T *bPtr = op->getInputs(1)->getRawDataPtr<T *>();
+    const T *packed = packedB<T>(*op);
+    T *outPtr = op->getOutput()->getRawDataPtr<T *>();
+    size_t nBatch = op->getOutput()->size() / (M * N);
+
+#pragma omp parallel for
+    for (size_t row = 0; row < nBatch * M; ++row) {
+      auto i = row % M;
+      int64_t aOffset = 0;
+      int64_t bOffset = 0;
+      int64_t biasOffset =
+          bias ? static_cast<int64_t>(i) * biasStrides[rank - 2] : 0;
+      auto rest = row / M;
+      for (auto d = batchRank; d > 0; --d) {
+        auto idx = static_cast<int64_t>(rest % outDim[d - 1]);
+        rest /= outDim[d - 1];
+        aOffset += idx * aStrides[d - 1];
+        bOffset += idx * bStrides[d - 1];
+        if (bias) {
+          biasOffset += idx * biasStrides[d - 1];
+        }
+      }
+      const T *a = aPtr + aOffset + static_cast<int64_t>(i) * aI;
+      const T *b = bPtr + bOffset;
+      auto aAt = [&](size_t p) { return a[static_cast<int64_t>(p) * aP]; };
+
+      for (size_t j0 = 0; j0 < N; j0 += TILE) {
+        auto n = std::min(TILE, N - j0);
+        T acc[TILE] = {};
+        if (packed) {
+          const T *panel = packed + j0 * K;
+          for (size_t p = 0; p < K; ++p) {
+            auto val = aAt(p);
+            const T *bRow = panel + p * n;
+            for (size_t j = 0; j < n; ++j) {
+              acc[j] += val * bRow[j];
+            }
+          }
+        } else if (bJ != 1 && bP == 1) {
+          // The columns of B are contiguous: dot products.
+          for (size_t j = 0; j < n; ++j) {
+            const T *bCol = b + static_cast<int64_t>(j0 + j) * bJ;
+            T sum = 0;
+            for (size_t p = 0; p < K; ++p) {
+              sum += aAt(p) * bCol[p];
+            }
+            acc[j] = sum;
+          }
+        } else {
+          for (size_t p = 0; p < K; ++p) {
+            auto val = aAt(p);
+            const T *bRow = b + static_cast<int64_t>(p) * bP +
+                            static_cast<int64_t>(j0) * bJ;
+            if (bJ == 1) {
+              for (size_t j = 0; j < n; ++j) {
+                acc[j] += val * bRow[j];
+              }
+            } else {
+              for (size_t j = 0; j < n; ++j) {
+                acc[j] += val * bRow[static_cast<int64_t>(j) * bJ];
+              }
+            }
+          }
+        }
+
+        // Epilogue on the tile while it is still hot. The output may share
+        // the bias buffer: each element is read before it is written.
+        if (alpha != T(1)) {
+          for (size_t j = 0; j < n; ++j) {
+            acc[j] *= alpha;
+          }
+        }
+        if (bias) {
+          auto stride = biasStrides[rank - 1];
+          const T *biasRow = biasPtr + biasOffset + j0 * stride;
+          for (size_t j = 0; j < n; ++j) {
+            acc[j] += beta * biasRow[j * stride];
+          }
+        }
+        if (epilogue.hasClamp()) {
+          for (size_t j = 0; j < n; ++j) {
+            auto val = acc[j];
+            if (epilogue.min && val < *epilogue.min) {
+              acc[j] = *epilogue.min;
+            } else if (epilogue.max && val > *epilogue.max) {
+              acc[j] = *epilogue.max;
+            }
+          }
+        }
+        std::copy(acc, acc + n, outPtr + row * N + j0);
+      }
+    }
+  }
+
+  // B packed for the Int8 kernel: cached on the operator if B is a constant,
+  // else packed into `scratch` on every run.
+  static const MatmulPackedB &packedInt8B(const MatmulObj &op,
+                                          MatmulPackedB &scratch) {
+    const auto &b = op.getInputs(1);
+    auto rank = op.getOutput()->getRank();
+    auto bStrides = broadcast_strides(b, rank);
+    IT_ASSERT(std::all_of(bStrides.begin(), bStrides.end() - 2,
+                          [](int64_t s) { return s == 0; }),
+              "Int8 MatMul needs an unbatched B");
+    auto transB = op.getTransB();
+    auto &packed = b->isConstant() ? op.getPackedB() : scratch;
+    if (!b->isConstant() || !isPackedFor(packed, b, INT8_PANEL, transB)) {
+      packInt8(b->getRawDataPtr<int8_t *>(),
+               bStrides[rank - (transB ? 1 : 2)],
+               bStrides[rank - (transB ? 2 : 1)], op.getN(), op.getK(),
+               packed);
+      setPackedFor(packed, b, INT8_PANEL, transB);
+    }
+    return packed;
+  }
+
+  static void computeInt8(const MatmulObj &op) {
+    size_t M = op.getM();
+    size_t K = op.getN();
+    size_t N = op.getK();
+    if (M == 0 || N == 0) {
+      return;
+    }
+    MatmulPackedB scratch;
+    const auto &packed = packedInt8B(op, scratch);
+    const auto &outDim = op.getOutput()->getDims();
+    auto rank = outDim.size();
+    auto aStrides = broadcast_strides(op.getInputs(0), rank);
+    auto aI = aStrides[rank - (op.getTransA() ? 1 : 2)];
+    auto aP = aStrides[rank - (op.getTransA() ? 2 : 1)];
+    const auto *aPtr = op.getInputs(0)->getRawDataPtr<int8_t *>();
+    auto *outPtr = op.getOutput()->getRawDataPtr<int32_t *>();
+    size_t nBatch = op.getOutput()->size() / (M * N);
+    auto K4 = roundUp(K, 4);
+#ifdef __x86_64__
+    auto row = hasVnni() ? int8RowVnni : int8Row;
+#else
+    auto row = int8Row;
+#endif
+
+#pragma omp parallel
+    {
+      // A row of A gathered contiguously and padded like B.
+      vector<int8_t> a(K4, 0);
+#pragma omp for
+      for (size_t r = 0; r < nBatch * M; ++r) {
+        auto aOffset = static_cast<int64_t>(r % M) * aI;
+        auto rest = r / M;
+        for (auto d = rank - 2; d > 0; --d) {
+          aOffset += static_cast<int64_t>(rest % outDim[d - 1]) *
+                     aStrides[d - 1];
+          rest /= outDim[d - 1];
+        }
+        for (size_t p = 0; p < K; ++p) {
+          a[p] = aPtr[aOffset + static_cast<int64_t>(p) * aP];
+        }
+        row(a.data(), packed, K4, N, outPtr + r * N);
+      }
+    }
+  }
+
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
+#define CASE(N)                                                                \
+  case N:                                                                      \
+    doCompute<DT<N>::t>(_op, context)
+
+    switch (_op->getDType().getIndex()) {
+      CASE(1); // DataType::Float32
+      break;
+      CASE(12); // DataType::UInt32
+      break;
+    case 3: // DataType::Int8
+      computeInt8(*as<MatmulObj>(_op));
+      break;
+    default:
+      IT_TODO_HALT();
+    }
+  }
+
+  void prepare(const Operator &_op, const RuntimeObj *context) const override {
+    auto op = as<MatmulObj>(_op);
+    if (op->getDType() == DataType::Float32) {
+      packedB<float>(*op);
+    } else if (op->getDType() == DataType::UInt32) {
+      packedB<uint32_t>(*op);
+    } else if (op->getDType() == DataType::Int8 &&
+               op->getInputs(1)->isConstant()) {
+      MatmulPackedB scratch;
+      packedInt8B(*op, scratch);
+    }
+  }
+};
+
+REGISTER_KERNEL(Device::CPU, OpType::MatMul, NaiveMatmul, "MatmulNaive_CPU");
+
+} // namespace infini
@@ -0,0 +1,112 @@
+#include "operators/quantize.h"
+#include "core/kernel.h"
+#include <cmath>
+#include <limits>
+
+namespace infini {
+
+namespace {
+// Maps an element index to the index of its scale: 0 for a per-tensor scale,
+// else the index along the axis.
+struct ChannelOf {
+  size_t inner = 1, count = 1;
+
+  ChannelOf(const Tensor &input, const Tensor &scale, int axis) {
+    if (scale->size() == 1) {
+      return;
+    }
+    const auto &dims = input->getDims();
+    count = dims[axis];
+    for (size_t i = axis + 1; i < dims.size(); ++i) {
+      inner *= dims[i];
+    }
+  }
+
+  size_t operator()(size_t i) const { return i / inner % count; }
+};
+} // namespace
+
+class NaiveQuantizeLinear : public CpuKernelWithoutConfig {
+  template <typename T>
+  void doCompute(const Operator &_op, const RuntimeObj *context) const {
+    auto op = as<QuantizeLinearObj>(_op);
+    ChannelOf channel(op->getInputs(0), op->getScale(), op->getAxis());
+    auto *x = op->getInputs(0)->getRawDataPtr<float *>();
+    auto *scale = op->getScale()->getRawDataPtr<float *>();
+    auto zeroPoint = op->getZeroPoint();
+    auto *zp = zeroPoint ? zeroPoint->getRawDataPtr<T *>() : nullptr;
+    auto *y = op->getOutput()->getRawDataPtr<T *>();
+    constexpr auto lo = static_cast<float>(std::numeric_limits<T>::min());
+    constexpr auto hi = static_cast<float>(std::numeric_limits<T>::max());
+    size_t size = op->getOutput()->size();
+#pragma omp parallel for
+    for (size_t i = 0; i < size; ++i) {
+      auto c = channel(i);
+      // Rounds half to even in the default rounding mode.
+      auto val = std::nearbyint(x[i] / scale[c]) + (zp ? zp[c] : 0);
+      y[i] = static_cast<T>(std::min(std::max(val, lo), hi));
+    }
+  }
+
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
+#define CASE(N)                                                                \
+  case N:                                                                      \
+    doCompute<DT<N>::t>(_op, context)
+
+    switch (_op->getOutput()->getDType().getIndex()) {
+      CASE(2); // DataType::UInt8
+      break;
+      CASE(3); // DataType::Int8
+      break;
+    default:
+      IT_TODO_HALT();
+    }
+#undef CASE
+  }
+};
+
+class NaiveDequantizeLinear : public CpuKernelWithoutConfig {
+  template <typename T>
+  void doCompute(const Operator &_op, const RuntimeObj *context) const {
+    auto op = as<DequantizeLinearObj>(_op);
+    ChannelOf channel(op->getInputs(0), op->getScale(), op->getAxis());
+    auto *x = op->getInputs(0)->getRawDataPtr<T *>();
+    auto *scale = op->getScale()->getRawDataPtr<float *>();
+    auto zeroPoint = op->getZeroPoint();
+    auto *zp = zeroPoint ? zeroPoint->getRawDataPtr<T *>() : nullptr;
+    auto *y = op->getOutput()->getRawDataPtr<float *>();
+    size_t size = op->getOutput()->size();
+#pragma omp parallel for
+    for (size_t i = 0; i < size; ++i) {
+      auto c = channel(i);
+      // In 64 bits, as an Int32 input minus its zero point may overflow.
+      auto val = static_cast<int64_t>(x[i]) - (zp ? zp[c] : 0);
+      y[i] = static_cast<float>(val) * scale[c];
+    }
+  }
+
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
+#define CASE(N)                                                                \
+  case N:                                                                      \
+    doCompute<DT<N>::t>(_op, context)
+
+    switch (_op->getDType().getIndex()) {
+      CASE(2); // DataType::UInt8
+      break;
+      CASE(3); // DataType::Int8
+      break;
+      CASE(6); // DataType::Int32
+      break;
+    default:
+      IT_TODO_HALT();
+    }
+#undef CASE
+  }
+};
+
+REGISTER_KERNEL(Device::CPU, OpType::QuantizeLinear, NaiveQuantizeLinear,
+                "QuantizeLinear_CPU");
+REGISTER_KERNEL(Device::CPU, OpType::DequantizeLinear, NaiveDequantizeLinear,
+                "DequantizeLinear_CPU");
+
+} // namespace infini
@@ -0,0 +1,30 @@
+#include "operators/reshape.h"
+#include "core/kernel.h"
+#include "utils/operator_utils.h"
+
+namespace infini {
+
+// Reshape, Flatten, Squeeze and Unsqueeze keep the elements in order. The
+// output is usually a view of the input; the copy is left for outputs that
+// are not, e.g. when folding constants.
+class NaiveCopy : public CpuKernelWithoutConfig {
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
+    const auto &input = _op->getInputs(0);
+    const auto &output = _op->getOutput();
+    if (input->getDataBlob() == output->getDataBlob()) {
+      return;
+    }
+    const auto &inDim = input->getDims();
+    copy_strided(output->getRawDataPtr<uint8_t *>(),
+                 TensorObj::contiguousStrides(inDim),
+                 input->getRawDataPtr<uint8_t *>(), input->getStrides(), inDim,
+                 input->getDType().getSize());
+  }
+};
+
+REGISTER_KERNEL(Device::CPU, OpType::Reshape, NaiveCopy, "Reshape_CPU");
+REGISTER_KERNEL(Device::CPU, OpType::Flatten, NaiveCopy, "Flatten_CPU");
+REGISTER_KERNEL(Device::CPU, OpType::Squeeze, NaiveCopy, "Squeeze_CPU");
+REGISTER_KERNEL(Device::CPU, OpType::Unsqueeze, NaiveCopy, "Unsqueeze_CPU");
+
+} // namespace infini
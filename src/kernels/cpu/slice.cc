@@ -0,0 +1,32 @@
+#include "operators/slice.h"
+#include "core/kernel.h"
+#include "utils/operator_utils.h"
+
+namespace infini {
+
+// Slice and Split outputs are usually views of the input; the copy is left for
+// outputs that are not, e.g. graph outputs or strided views a consumer cannot
+// read. Each output is copied from the range inferView() would point it at.
+class NaiveSliceCopy : public CpuKernelWithoutConfig {
+  void compute(const Operator &_op, const RuntimeObj *context) const override {
+    const auto &input = _op->getInputs(0);
+    auto elemSize = input->getDType().getSize();
+    auto *base = input->getDataBlob()->getPtr<uint8_t *>();
+    const auto &outputs = _op->getOutputs();
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      const auto &output = outputs[i];
+      if (output->getDataBlob() == input->getDataBlob()) {
+        continue;
+      }
+      auto [strides, offset] = _op->inferView(i);
+      copy_strided(output->getRawDataPtr<uint8_t *>(), output->getStrides(),
+                   base + offset * elemSize, strides, output->getDims(),
+                   elemSize);
+    }
+  }
+};
+
+REGISTER_KERNEL(Device::CPU, OpType::Slice, NaiveSliceCopy, "Slice_CPU");
+REGISTER_KERNEL(Device::CPU, OpType::Split, NaiveSliceCopy, "Split_CPU");
+
+} // namespace infini
@@ -3,36 +3,36 @@
 
 namespace infini {
 
-inline Shape idx2Pos(const Shape &shape, size_t idx) {
-  Shape pos = Shape(shape.size(), 0);
-  auto rest = idx;
-  auto curDimId = shape.size() - 1;
-  while (rest > 0) {
-    pos[curDimId] = static_cast<int>(rest) % shape[curDimId];
-    rest /= shape[curDimId];
-    curDimId--;
-  }
-  return pos;
-}
-
 class NaiveTranspose : public CpuKernelWithoutConfig {
   template <typename T>
   void doCompute(const Operator &_op, const RuntimeObj *context) const {
     auto op = as<TransposeObj>(_op);
-    auto inputs = op->getInputs();
-    auto outputs = op->getOutputs();
-    const auto &inDim = inputs[0]->getDims();
+    const auto &input = op->getInputs(0);
+    const auto &output = op->getOutput();
+    if (input->getDataBlob() == output->getDataBlob()) {
+      // The output is a view of the input, see TransposeObj::getViewInput.
+      return;
+    }
+    const auto &outDim = output->getDims();
     const auto &perm = op->getPermute();
+    auto rank = outDim.size();
+    // Strides of the input along the output dimensions. The input may be a
+    // view itself.
+    Strides strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      strides[i] = input->getStrides()[perm[i]];
+    }
 
-    size_t inSize = inputs[0]->size();
-    auto *inPtr = inputs[0]->getRawDataPtr<T *>();
-    auto *outPtr = outputs[0]->getRawDataPtr<T *>();
+    size_t outSize = output->size();
+    auto *inPtr = input->getRawDataPtr<T *>();
+    auto *outPtr = output->getRawDataPtr<T *>();
 #pragma omp parallel for
-    for (size_t inIdx = 0; inIdx < inSize; ++inIdx) {
-      auto posInput = idx2Pos(inDim, inIdx);
-      int outIdx = 0;
-      for (int j : perm) {
-        outIdx = outIdx * inDim[j] + posInput[j];
+    for (size_t outIdx = 0; outIdx < outSize; ++outIdx) {
+      auto rest = outIdx;
+      int64_t inIdx = 0;
+      for (auto d = rank; d > 0; --d) {
+        inIdx += static_cast<int64_t>(rest % outDim[d - 1]) * strides[d - 1];
+        rest /= outDim[d - 1];
       }
       outPtr[outIdx] = inPtr[inIdx];
     }
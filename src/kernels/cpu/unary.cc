@@ -14,7 +14,6 @@ class NativeUnary : public CpuKernelWithoutConfig {
     T *inptr = op->getInputs(0)->getRawDataPtr<T *>();
     T *outptr = op->getOutput()->getRawDataPtr<T *>();
 
-    auto outDim = op->getOutput()->getDims();
     auto n = op->getOutput()->size();
 
     T (*_doCompute)(T val){nullptr};
@@ -49,6 +49,10 @@ optional<vector<Shape>> ConcatObj::inferShape(const TensorVec &inputs) {
   return {{output_shape}};
 }
 
+vector<int> ConcatObj::getOpAttrVector() const {
+  return {type.underlying(), dim};
+}
+
 std::string ConcatObj::toString() const {
   std::ostringstream os;
   os << "Concat[" << getGuid() << "]";
@@ -0,0 +1,89 @@
+#include "operators/fused_element_wise.h"
+
+#include "utils/operator_utils.h"
+#include <utility>
+
+namespace infini {
+
+FusedElementWiseObj::FusedElementWiseObj(GraphObj *graph,
+                                         const TensorVec &inputs,
+                                         Tensor output,
+                                         vector<FusedStep> steps)
+    : OperatorObj(OpType::FusedElementWise, inputs, {std::move(output)}),
+      steps(std::move(steps)) {
+  IT_ASSERT(!this->steps.empty());
+  for (const auto &step : this->steps) {
+    IT_ASSERT(isFusible(step.type));
+    auto binary = step.type != OpType::Relu && step.type != OpType::Clip;
+    IT_ASSERT(binary == (step.operand >= 0));
+    IT_ASSERT(step.operand < static_cast<int>(inputs.size()));
+  }
+  IT_ASSERT(checkValid(graph));
+}
+
+bool FusedElementWiseObj::isFusible(OpType type) {
+  switch (type.underlying()) {
+  case OpType::Add:
+  case OpType::Sub:
+  case OpType::Mul:
+  case OpType::Div:
+  case OpType::Relu:
+  case OpType::Clip:
+    return true;
+  default:
+    return false;
+  }
+}
+
+optional<vector<Shape>>
+FusedElementWiseObj::inferShape(const TensorVec &inputs) {
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+  auto dtype = inputs[0]->getDType();
+  Shape res = inputs[0]->getDims();
+  for (size_t i = 1; i < inputs.size(); ++i) {
+    if (!(inputs[i]->getDType() == dtype)) {
+      return std::nullopt;
+    }
+    auto rank = std::max(res.size(), inputs[i]->getRank());
+    res = infer_broadcast(res, inputs[i]->getDims());
+    if (res.size() != rank) {
+      return std::nullopt;
+    }
+  }
+  return {{res}};
+}
+
+vector<int> FusedElementWiseObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  for (const auto &step : steps) {
+    ret.emplace_back(step.type.underlying());
+    ret.emplace_back(step.operand);
+    ret.emplace_back(step.operandFirst);
+    append_attr(ret, step.min);
+    append_attr(ret, step.max);
+  }
+  return ret;
+}
+
+std::string FusedElementWiseObj::toString() const {
+  std::ostringstream os;
+  os << type.toString() << "[" << getGuid() << "]";
+  os << "(";
+  for (const auto &step : steps) {
+    os << step.type.toString();
+    if (step.operand >= 0) {
+      os << "#" << step.operand;
+    }
+    os << ", ";
+  }
+  os << "input=";
+  for (const auto &input : inputs) {
+    os << input->getGuid() << ", ";
+  }
+  os << "output=" << outputs[0]->getGuid() << ")";
+  return os.str();
+}
+
+} // namespace infini
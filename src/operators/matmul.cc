@@ -1,30 +1,95 @@
 #include "operators/matmul.h"
 #include "core/tensor.h"
 #include "utils/operator_utils.h"
+#include <algorithm>
 #include <iterator>
 #include <utility>
 
 namespace infini {
 
+bool MatmulEpilogue::composeClamp(optional<float> newMin,
+                                  optional<float> newMax) {
+  auto lo = min;
+  auto hi = max;
+  if (newMin) {
+    lo = lo ? std::max(*lo, *newMin) : newMin;
+  }
+  if (newMax) {
+    hi = hi ? std::min(*hi, *newMax) : newMax;
+  }
+  // Two clamps only compose into one when their ranges overlap.
+  if (lo && hi && *lo > *hi) {
+    return false;
+  }
+  min = lo;
+  max = hi;
+  return true;
+}
+
 MatmulObj::MatmulObj(GraphObj *graph, Tensor A, Tensor B, Tensor C, bool transA,
-                     bool transB)
+                     bool transB, Tensor bias, MatmulEpilogue epilogue)
     : OperatorObj(OpType::MatMul, TensorVec{std::move(A), std::move(B)},
                   {std::move(C)}),
-      transA(transA), transB(transB) {
+      transA(transA), transB(transB), epilogue(epilogue) {
+  if (bias) {
+    inputs.emplace_back(std::move(bias));
+  }
   IT_ASSERT(checkValid(graph));
 }
 
+vector<int> MatmulObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying(), transA, transB};
+  append_attr(ret, epilogue.alpha);
+  append_attr(ret, epilogue.beta);
+  append_attr(ret, epilogue.min);
+  append_attr(ret, epilogue.max);
+  return ret;
+}
+
+optional<int> MatmulObj::getInplaceInput() const {
+  // Every element of the output reads the same element of the bias first.
+  if (inputs.size() > 2 && inputs[2]->getDims() == outputs[0]->getDims() &&
+      inputs[2]->getDType() == outputs[0]->getDType()) {
+    return 2;
+  }
+  return std::nullopt;
+}
+
 string MatmulObj::toString() const {
   std::ostringstream os;
   os << "Matmul([" << (transA ? "A^T" : "A") << "," << (transB ? "B^T" : "B]")
      << ", A=" << inputs[0]->getGuid() << ", B=" << inputs[1]->getGuid()
      << ", C=" << outputs[0]->getGuid() << ", mnk=[" << m << "," << n << ","
-     << k << "])";
+     << k << "]";
+  if (inputs.size() > 2) {
+    os << ", bias=" << inputs[2]->getGuid();
+  }
+  if (epilogue.alpha != 1.f) {
+    os << ", alpha=" << epilogue.alpha;
+  }
+  if (epilogue.beta != 1.f) {
+    os << ", beta=" << epilogue.beta;
+  }
+  if (epilogue.min) {
+    os << ", min=" << *epilogue.min;
+  }
+  if (epilogue.max) {
+    os << ", max=" << *epilogue.max;
+  }
+  os << ")";
   return os.str();
 }
 
+vector<DataType> MatmulObj::inferDataType(const TensorVec &inputs) const {
+  // Int8 products accumulate in Int32.
+  if (inputs[0]->getDType() == DataType::Int8) {
+    return {DataType::Int32};
+  }
+  return {inputs[0]->getDType()};
+}
+
 optional<vector<Shape>> MatmulObj::inferShape(const TensorVec &inputs) {
-  if (inputs.size() != 2) {
+  if (inputs.size() != 2 && inputs.size() != 3) {
     return std::nullopt;
   }
 
@@ -38,6 +103,15 @@ optional<vector<Shape>> MatmulObj::inferShape(const TensorVec &inputs) {
   if (A->getRank() < 2 || B->getRank() < 2) {
     return std::nullopt;
   }
+  // The Int8 kernel also reads a single B for every batch.
+  if ((A->getDType() == DataType::Int8 || B->getDType() == DataType::Int8) &&
+      (!(A->getDType() == B->getDType()) || inputs.size() > 2 ||
+       epilogue.alpha != 1.f || epilogue.beta != 1.f ||
+       epilogue.hasClamp() ||
+       std::any_of(B_shape.begin(), B_shape.end() - 2,
+                   [](ShapeElem d) { return d != 1; }))) {
+    return std::nullopt;
+  }
 
   // 1. Deal with `A, B`'s last 2 dims
   auto checked_A_dim_len = transA ? A_shape[A_rank - 2] : A_shape[A_rank - 1];
@@ -50,20 +124,25 @@ optional<vector<Shape>> MatmulObj::inferShape(const TensorVec &inputs) {
   k = transB ? B_shape[B_rank - 2] : B_shape[B_rank - 1];
 
   Shape part_b{m, k};
+  Shape part_a;
 
-  if (A_rank == 2 && B_rank == 2) {
-    return {{part_b}};
+  if (A_rank != 2 || B_rank != 2) {
+    // 2. Broadcast the rest of the `A, B`'s previous dims
+    Shape A_part_a(A_shape.begin(), A_shape.end() - 2);
+    Shape B_part_a(B_shape.begin(), B_shape.end() - 2);
+    part_a = infer_broadcast(A_part_a, B_part_a);
   }
 
-  // 2. Broadcast the rest of the `A, B`'s previous dims
-  Shape A_part_a(A_shape.begin(), A_shape.end() - 2);
-  Shape B_part_a(B_shape.begin(), B_shape.end() - 2);
-  Shape part_a = infer_broadcast(A_part_a, B_part_a);
-
   // 3. Concatenate
   part_a.reserve(part_a.size() + part_b.size());
   part_a.insert(part_a.end(), std::make_move_iterator(part_b.begin()),
                 std::make_move_iterator(part_b.end()));
+
+  // 4. The bias must broadcast to the output without changing its shape
+  if (inputs.size() == 3 &&
+      infer_broadcast(part_a, inputs[2]->getDims()) != part_a) {
+    return std::nullopt;
+  }
   return {{part_a}};
 }
 
@@ -0,0 +1,128 @@
+#include "operators/quantize.h"
+
+#include "utils/operator_utils.h"
+#include <utility>
+
+namespace infini {
+
+namespace {
+TensorVec quantizeInputs(Tensor input, Tensor scale, Tensor zeroPoint) {
+  TensorVec ret{std::move(input), std::move(scale)};
+  if (zeroPoint) {
+    ret.emplace_back(std::move(zeroPoint));
+  }
+  return ret;
+}
+
+int realAxis(const Tensor &input, int axis) {
+  int rank = static_cast<int>(input->getRank());
+  if (rank == 0) {
+    return 0;
+  }
+  IT_ASSERT(axis >= -rank && axis < rank, "Axis out of range");
+  return get_real_axis(axis, rank);
+}
+
+// A Float32 scale with one value, or one per index of `axis`, and a zero
+// point of the same shape.
+bool validParams(const TensorVec &inputs, int axis) {
+  const auto &input = inputs[0];
+  const auto &scale = inputs[1];
+  if (!(scale->getDType() == DataType::Float32) || scale->getRank() > 1 ||
+      (scale->size() != 1 &&
+       (input->getRank() == 0 ||
+        scale->size() != static_cast<size_t>(input->getDims()[axis])))) {
+    return false;
+  }
+  return inputs.size() < 3 || inputs[2]->getDims() == scale->getDims();
+}
+
+string quantizeToString(const OperatorObj &op, int axis) {
+  std::ostringstream os;
+  os << op.getOpType().toString() << "[" << op.getGuid() << "]";
+  os << "(";
+  os << vecToString(op.getInputs(0)->getDims()) << ", ";
+  os << "axis=" << axis << ", ";
+  os << "input=" << op.getInputs(0)->getGuid() << ", ";
+  os << "scale=" << op.getInputs(1)->getGuid() << ", ";
+  if (op.getInputs().size() > 2) {
+    os << "zeroPoint=" << op.getInputs(2)->getGuid() << ", ";
+  }
+  os << "output=" << op.getOutput()->getGuid() << ")";
+  return os.str();
+}
+} // namespace
+
+QuantizeLinearObj::QuantizeLinearObj(GraphObj *graph, Tensor input,
+                                     Tensor scale, Tensor zeroPoint,
+                                     Tensor output, int axis)
+    : OperatorObj(OpType::QuantizeLinear,
+                  quantizeInputs(std::move(input), std::move(scale),
+                                 std::move(zeroPoint)),
+                  {std::move(output)}),
+      axis(realAxis(inputs[0], axis)) {
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> QuantizeLinearObj::inferShape(const TensorVec &inputs) {
+  if (!(inputs[0]->getDType() == DataType::Float32) ||
+      !validParams(inputs, axis)) {
+    return std::nullopt;
+  }
+  if (inputs.size() > 2 && !(inputs[2]->getDType() == DataType::Int8) &&
+      !(inputs[2]->getDType() == DataType::UInt8)) {
+    return std::nullopt;
+  }
+  return {{inputs[0]->getDims()}};
+}
+
+vector<DataType>
+QuantizeLinearObj::inferDataType(const TensorVec &inputs) const {
+  return {inputs.size() > 2 ? inputs[2]->getDType() : DataType::UInt8};
+}
+
+vector<int> QuantizeLinearObj::getOpAttrVector() const {
+  return {type.underlying(), axis};
+}
+
+std::string QuantizeLinearObj::toString() const {
+  return quantizeToString(*this, axis);
+}
+
+DequantizeLinearObj::DequantizeLinearObj(GraphObj *graph, Tensor input,
+                                         Tensor scale, Tensor zeroPoint,
+                                         Tensor output, int axis)
+    : OperatorObj(OpType::DequantizeLinear,
+                  quantizeInputs(std::move(input), std::move(scale),
+                                 std::move(zeroPoint)),
+                  {std::move(output)}),
+      axis(realAxis(inputs[0], axis)) {
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>>
+DequantizeLinearObj::inferShape(const TensorVec &inputs) {
+  auto dtype = inputs[0]->getDType();
+  if ((!(dtype == DataType::Int8) && !(dtype == DataType::UInt8) &&
+       !(dtype == DataType::Int32)) ||
+      !validParams(inputs, axis) ||
+      (inputs.size() > 2 && !(inputs[2]->getDType() == dtype))) {
+    return std::nullopt;
+  }
+  return {{inputs[0]->getDims()}};
+}
+
+vector<DataType>
+DequantizeLinearObj::inferDataType(const TensorVec &inputs) const {
+  return {DataType::Float32};
+}
+
+vector<int> DequantizeLinearObj::getOpAttrVector() const {
+  return {type.underlying(), axis};
+}
+
+std::string DequantizeLinearObj::toString() const {
+  return quantizeToString(*this, axis);
+}
+
+} // namespace infini
@@ -0,0 +1,220 @@
+#include "operators/reshape.h"
+
+#include "utils/operator_utils.h"
+#include <algorithm>
+#include <utility>
+
+namespace infini {
+
+namespace {
+// Axes normalized against `rank` and sorted.
+vector<int> realAxes(vector<int> axes, int rank) {
+  for (auto &axis : axes) {
+    IT_ASSERT(axis >= -rank && axis < rank, "Axis out of range");
+    axis = get_real_axis(axis, rank);
+  }
+  std::sort(axes.begin(), axes.end());
+  IT_ASSERT(std::adjacent_find(axes.begin(), axes.end()) == axes.end(),
+            "Duplicate axes");
+  return axes;
+}
+
+bool hasAxis(const vector<int> &axes, size_t i) {
+  return std::binary_search(axes.begin(), axes.end(), static_cast<int>(i));
+}
+
+// The view of a contiguous input in a new shape.
+std::pair<Strides, size_t> contiguousView(const Tensor &input,
+                                          const Tensor &output) {
+  IT_ASSERT(input->isContiguous());
+  return {TensorObj::contiguousStrides(output->getDims()), input->getOffset()};
+}
+
+string reshapeToString(const OperatorObj &op, const string &attrs) {
+  std::ostringstream os;
+  os << op.getOpType().toString() << "[" << op.getGuid() << "]";
+  os << "(";
+  os << vecToString(op.getInputs(0)->getDims()) << ", ";
+  os << attrs;
+  os << "input=" << op.getInputs(0)->getGuid() << ", ";
+  os << "output=" << op.getOutput()->getGuid() << ")";
+  return os.str();
+}
+} // namespace
+
+ReshapeObj::ReshapeObj(GraphObj *graph, Tensor input, Tensor output,
+                       Shape dims)
+    : OperatorObj(OpType::Reshape, {std::move(input)}, {std::move(output)}),
+      dims(std::move(dims)) {
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> ReshapeObj::inferShape(const TensorVec &inputs) {
+  const auto &inDims = inputs[0]->getDims();
+  Shape ret = dims;
+  optional<size_t> inferred;
+  size_t size = 1;
+  for (size_t i = 0; i < ret.size(); ++i) {
+    if (ret[i] == 0) {
+      if (i >= inDims.size()) {
+        return std::nullopt;
+      }
+      ret[i] = inDims[i];
+    } else if (ret[i] == -1) {
+      if (inferred) {
+        return std::nullopt;
+      }
+      inferred = i;
+      continue;
+    } else if (ret[i] < 0) {
+      return std::nullopt;
+    }
+    size *= ret[i];
+  }
+  if (inferred) {
+    if (size == 0 || inputs[0]->size() % size != 0) {
+      return std::nullopt;
+    }
+    ret[*inferred] = static_cast<ShapeElem>(inputs[0]->size() / size);
+  } else if (size != inputs[0]->size()) {
+    return std::nullopt;
+  }
+  return {{ret}};
+}
+
+std::pair<Strides, size_t> ReshapeObj::inferView(size_t) const {
+  return contiguousView(inputs[0], outputs[0]);
+}
+
+vector<int> ReshapeObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  ret.insert(ret.end(), dims.begin(), dims.end());
+  return ret;
+}
+
+std::string ReshapeObj::toString() const {
+  return reshapeToString(*this, "dims=" + vecToString(dims) + ", ");
+}
+
+FlattenObj::FlattenObj(GraphObj *graph, Tensor input, Tensor output, int axis)
+    : OperatorObj(OpType::Flatten, {std::move(input)}, {std::move(output)}) {
+  int rank = static_cast<int>(inputs[0]->getRank());
+  IT_ASSERT(axis >= -rank && axis <= rank, "Axis out of range");
+  this->axis = axis < 0 ? axis + rank : axis;
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> FlattenObj::inferShape(const TensorVec &inputs) {
+  const auto &inDims = inputs[0]->getDims();
+  if (static_cast<size_t>(axis) > inDims.size()) {
+    return std::nullopt;
+  }
+  ShapeElem rows = 1;
+  ShapeElem cols = 1;
+  for (size_t i = 0; i < inDims.size(); ++i) {
+    (static_cast<int>(i) < axis ? rows : cols) *= inDims[i];
+  }
+  return {{{rows, cols}}};
+}
+
+std::pair<Strides, size_t> FlattenObj::inferView(size_t) const {
+  return contiguousView(inputs[0], outputs[0]);
+}
+
+vector<int> FlattenObj::getOpAttrVector() const {
+  return {type.underlying(), axis};
+}
+
+std::string FlattenObj::toString() const {
+  return reshapeToString(*this, "axis=" + std::to_string(axis) + ", ");
+}
+
+SqueezeObj::SqueezeObj(GraphObj *graph, Tensor input, Tensor output,
+                       vector<int> axes)
+    : OperatorObj(OpType::Squeeze, {std::move(input)}, {std::move(output)}),
+      axes(realAxes(std::move(axes),
+                    static_cast<int>(inputs[0]->getRank()))) {
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> SqueezeObj::inferShape(const TensorVec &inputs) {
+  const auto &inDims = inputs[0]->getDims();
+  Shape ret;
+  for (size_t i = 0; i < inDims.size(); ++i) {
+    auto squeezed = axes.empty() ? inDims[i] == 1 : hasAxis(axes, i);
+    if (!squeezed) {
+      ret.emplace_back(inDims[i]);
+    } else if (inDims[i] != 1) {
+      return std::nullopt;
+    }
+  }
+  return {{ret}};
+}
+
+std::pair<Strides, size_t> SqueezeObj::inferView(size_t) const {
+  const auto &input = inputs[0];
+  Strides strides;
+  for (size_t i = 0; i < input->getRank(); ++i) {
+    auto squeezed =
+        axes.empty() ? input->getDims()[i] == 1 : hasAxis(axes, i);
+    if (!squeezed) {
+      strides.emplace_back(input->getStrides()[i]);
+    }
+  }
+  return {strides, input->getOffset()};
+}
+
+vector<int> SqueezeObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  ret.insert(ret.end(), axes.begin(), axes.end());
+  return ret;
+}
+
+std::string SqueezeObj::toString() const {
+  return reshapeToString(*this, "axes=" + vecToString(axes) + ", ");
+}
+
+UnsqueezeObj::UnsqueezeObj(GraphObj *graph, Tensor input, Tensor output,
+                           vector<int> axes)
+    : OperatorObj(OpType::Unsqueeze, {std::move(input)}, {std::move(output)}) {
+  auto rank = inputs[0]->getRank() + axes.size();
+  this->axes = realAxes(std::move(axes), static_cast<int>(rank));
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> UnsqueezeObj::inferShape(const TensorVec &inputs) {
+  const auto &inDims = inputs[0]->getDims();
+  Shape ret;
+  auto in = inDims.begin();
+  for (size_t i = 0; i < inDims.size() + axes.size(); ++i) {
+    if (hasAxis(axes, i)) {
+      ret.emplace_back(1);
+    } else {
+      ret.emplace_back(*in++);
+    }
+  }
+  return {{ret}};
+}
+
+std::pair<Strides, size_t> UnsqueezeObj::inferView(size_t) const {
+  const auto &input = inputs[0];
+  Strides strides;
+  auto in = input->getStrides().begin();
+  for (size_t i = 0; i < outputs[0]->getRank(); ++i) {
+    // The stride of a new dimension is never used.
+    strides.emplace_back(hasAxis(axes, i) ? 0 : *in++);
+  }
+  return {strides, input->getOffset()};
+}
+
+vector<int> UnsqueezeObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  ret.insert(ret.end(), axes.begin(), axes.end());
+  return ret;
+}
+
+std::string UnsqueezeObj::toString() const {
+  return reshapeToString(*this, "axes=" + vecToString(axes) + ", ");
+}
+
+} // namespace infini
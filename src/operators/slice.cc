@@ -0,0 +1,114 @@
+#include "operators/slice.h"
+
+#include "utils/operator_utils.h"
+#include <algorithm>
+#include <utility>
+
+namespace infini {
+
+namespace {
+// An onnx Slice index: negative counts from the end, and out of range is
+// clamped to [0, dim].
+int clampIndex(int index, int dim) {
+  auto ret = static_cast<int64_t>(index);
+  if (ret < 0) {
+    ret += dim;
+  }
+  return static_cast<int>(std::clamp<int64_t>(ret, 0, dim));
+}
+} // namespace
+
+SliceObj::SliceObj(GraphObj *graph, Tensor input, Tensor output,
+                   const vector<int> &starts, const vector<int> &ends,
+                   const optional<vector<int>> &axes,
+                   const optional<vector<int>> &steps)
+    : OperatorObj(OpType::Slice, {std::move(input)}, {std::move(output)}) {
+  const auto &dims = inputs[0]->getDims();
+  int rank = static_cast<int>(dims.size());
+  IT_ASSERT(starts.size() == ends.size(), "Starts and ends differ in length");
+  IT_ASSERT(!axes || axes->size() == starts.size(), "Wrong number of axes");
+  IT_ASSERT(!steps || steps->size() == starts.size(), "Wrong number of steps");
+  this->starts.assign(rank, 0);
+  this->ends.assign(dims.begin(), dims.end());
+  this->steps.assign(rank, 1);
+  for (size_t i = 0; i < starts.size(); ++i) {
+    auto axis = axes ? (*axes)[i] : static_cast<int>(i);
+    IT_ASSERT(axis >= -rank && axis < rank, "Axis out of range");
+    axis = get_real_axis(axis, rank);
+    auto step = steps ? (*steps)[i] : 1;
+    IT_ASSERT(step > 0, "Only positive steps are supported");
+    this->starts[axis] = clampIndex(starts[i], dims[axis]);
+    this->ends[axis] = clampIndex(ends[i], dims[axis]);
+    this->steps[axis] = step;
+  }
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> SliceObj::inferShape(const TensorVec &inputs) {
+  const auto &inDims = inputs[0]->getDims();
+  if (inDims.size() != starts.size()) {
+    return std::nullopt;
+  }
+  Shape ret;
+  for (size_t i = 0; i < inDims.size(); ++i) {
+    if (ends[i] > inDims[i]) {
+      return std::nullopt;
+    }
+    auto len = std::max(ends[i] - starts[i], 0);
+    ret.emplace_back((len + steps[i] - 1) / steps[i]);
+  }
+  return {{ret}};
+}
+
+std::pair<Strides, size_t> SliceObj::inferView(size_t) const {
+  const auto &input = inputs[0];
+  Strides strides = input->getStrides();
+  auto offset = static_cast<int64_t>(input->getOffset());
+  for (size_t i = 0; i < strides.size(); ++i) {
+    offset += starts[i] * strides[i];
+    strides[i] *= steps[i];
+  }
+  return {strides, static_cast<size_t>(offset)};
+}
+
+bool SliceObj::preservesContiguity() const {
+  const auto &inDims = inputs[0]->getDims();
+  const auto &outDims = outputs[0]->getDims();
+  // Whole trailing dimensions, then at most one range with a step of 1, then
+  // dimensions of size 1.
+  auto i = outDims.size();
+  while (i > 0 && outDims[i - 1] == inDims[i - 1]) {
+    --i;
+  }
+  if (i > 0) {
+    --i;
+    if (steps[i] != 1 && outDims[i] != 1) {
+      return false;
+    }
+  }
+  return std::all_of(outDims.begin(), outDims.begin() + i,
+                     [](ShapeElem d) { return d == 1; });
+}
+
+vector<int> SliceObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  ret.insert(ret.end(), starts.begin(), starts.end());
+  ret.insert(ret.end(), ends.begin(), ends.end());
+  ret.insert(ret.end(), steps.begin(), steps.end());
+  return ret;
+}
+
+std::string SliceObj::toString() const {
+  std::ostringstream os;
+  os << "Slice[" << getGuid() << "]";
+  os << "(";
+  os << vecToString(inputs[0]->getDims()) << ", ";
+  os << "starts=" << vecToString(starts) << ", ";
+  os << "ends=" << vecToString(ends) << ", ";
+  os << "steps=" << vecToString(steps) << ", ";
+  os << "input=" << inputs[0]->getGuid() << ", ";
+  os << "output=" << outputs[0]->getGuid() << ")";
+  return os.str();
+}
+
+} // namespace infini
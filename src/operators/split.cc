@@ -0,0 +1,84 @@
+#include "operators/split.h"
+
+#include "utils/operator_utils.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace infini {
+
+namespace {
+vector<int> evenSizes(const Tensor &input, int dim, int num) {
+  int rank = static_cast<int>(input->getRank());
+  auto size = input->getDims()[get_real_axis(dim, rank)];
+  IT_ASSERT(num > 0 && size % num == 0, "Split does not divide evenly");
+  return vector<int>(num, size / num);
+}
+} // namespace
+
+SplitObj::SplitObj(GraphObj *graph, Tensor input,
+                   const optional<TensorVec> &outputs, int dim, int num)
+    : SplitObj(graph, input, outputs, dim, evenSizes(input, dim, num)) {}
+
+SplitObj::SplitObj(GraphObj *graph, Tensor input,
+                   const optional<TensorVec> &outputs, int dim,
+                   vector<int> sizes)
+    : OperatorObj(OpType::Split, {std::move(input)},
+                  outputs ? *outputs : TensorVec(sizes.size(), nullptr)),
+      sizes(std::move(sizes)) {
+  int rank = static_cast<int>(inputs[0]->getRank());
+  this->dim = get_real_axis(dim, rank);
+  IT_ASSERT(checkValid(graph));
+}
+
+optional<vector<Shape>> SplitObj::inferShape(const TensorVec &inputs) {
+  const auto &inDims = inputs[0]->getDims();
+  if (static_cast<size_t>(dim) >= inDims.size() ||
+      std::any_of(sizes.begin(), sizes.end(), [](int s) { return s < 0; }) ||
+      std::accumulate(sizes.begin(), sizes.end(), 0) != inDims[dim]) {
+    return std::nullopt;
+  }
+  vector<Shape> ret;
+  for (auto size : sizes) {
+    ret.emplace_back(inDims);
+    ret.back()[dim] = size;
+  }
+  return ret;
+}
+
+std::pair<Strides, size_t> SplitObj::inferView(size_t i) const {
+  const auto &input = inputs[0];
+  auto start = std::accumulate(sizes.begin(), sizes.begin() + i, 0);
+  return {input->getStrides(),
+          input->getOffset() + start * input->getStrides()[dim]};
+}
+
+bool SplitObj::preservesContiguity() const {
+  const auto &inDims = inputs[0]->getDims();
+  return std::all_of(inDims.begin(), inDims.begin() + dim,
+                     [](ShapeElem d) { return d == 1; });
+}
+
+vector<int> SplitObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying(), dim};
+  ret.insert(ret.end(), sizes.begin(), sizes.end());
+  return ret;
+}
+
+std::string SplitObj::toString() const {
+  std::ostringstream os;
+  os << "Split[" << getGuid() << "]";
+  os << "(";
+  os << vecToString(inputs[0]->getDims()) << ", ";
+  os << "dim=" << dim << ", ";
+  os << "sizes=" << vecToString(sizes) << ", ";
+  os << "input=" << inputs[0]->getGuid() << ", ";
+  os << "output=";
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    os << (i ? ", " : "") << outputs[i]->getGuid();
+  }
+  os << ")";
+  return os.str();
+}
+
+} // namespace infini
@@ -42,6 +42,21 @@ optional<vector<Shape>> TransposeObj::inferShape(const TensorVec &inputs) {
   return std::nullopt;
 }
 
+vector<int> TransposeObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  ret.insert(ret.end(), transposePermute.begin(), transposePermute.end());
+  return ret;
+}
+
+std::pair<Strides, size_t> TransposeObj::inferView(size_t) const {
+  const auto &input = inputs[0];
+  Strides strides;
+  for (auto i : transposePermute) {
+    strides.emplace_back(input->getStrides()[i]);
+  }
+  return {strides, input->getOffset()};
+}
+
 std::string TransposeObj::toString() const {
   std::ostringstream os;
   os << type.toString() << "[" << getGuid() << "]";
@@ -1,5 +1,6 @@
 #include "operators/unary.h"
 
+#include "utils/operator_utils.h"
 #include <utility>
 
 namespace infini {
@@ -40,6 +41,13 @@ optional<vector<Shape>> ClipObj::inferShape(const TensorVec &inputs) {
   return shapes;
 }
 
+vector<int> ClipObj::getOpAttrVector() const {
+  vector<int> ret{type.underlying()};
+  append_attr(ret, minValue);
+  append_attr(ret, maxValue);
+  return ret;
+}
+
 std::string ClipObj::toString() const {
   std::ostringstream os;
   os << type.toString() << "[" << getGuid() << "]";
@@ -69,6 +77,10 @@ optional<vector<Shape>> CastObj::inferShape(const TensorVec &inputs) {
   return shapes;
 }
 
+vector<int> CastObj::getOpAttrVector() const {
+  return {type.underlying(), static_cast<int>(castType)};
+}
+
 std::string CastObj::toString() const {
   std::ostringstream os;
   os << type.toString() << "[" << getGuid() << "]";
@@ -77,8 +89,67 @@ std::string CastObj::toString() const {
   return os.str();
 }
 
+DataType CastObj::getInputDataType() const {
+  return getInputDataType(castType);
+}
+
 DataType CastObj::getOutputDataType() const {
-  switch (castType) {
+  return getOutputDataType(castType);
+}
+
+DataType CastObj::getInputDataType(CastType type) {
+  switch (type) {
+  case CastType::Float2Float16:
+  case CastType::Float2Int64:
+  case CastType::Float2Int32:
+  case CastType::Float2Int16:
+  case CastType::Float2Int8:
+  case CastType::Float2BFloat16:
+  case CastType::Float2Float:
+    return DataType::Float32;
+  case CastType::Int322Float:
+  case CastType::Int322Int8:
+  case CastType::Int322Int16:
+  case CastType::Int322Int64:
+    return DataType::Int32;
+  case CastType::Int162Float:
+  case CastType::Int162Int32:
+    return DataType::Int16;
+  case CastType::Int82Float:
+  case CastType::Int82Int16:
+  case CastType::Int82Int32:
+    return DataType::Int8;
+  case CastType::Uint82Float:
+  case CastType::Uint82Int32:
+  case CastType::Uint82Int64:
+    return DataType::UInt8;
+  case CastType::Int642Int32:
+  case CastType::Int642Uint32:
+  case CastType::Int642Float:
+    return DataType::Int64;
+  case CastType::Uint322Int64:
+    return DataType::UInt32;
+  case CastType::Float162Float:
+    return DataType::Float16;
+  case CastType::BFloat162Float:
+    return DataType::BFloat16;
+  default:
+    IT_TODO_HALT();
+  }
+}
+
+optional<CastType> CastObj::getCastType(DataType from, DataType to) {
+  for (auto i = 0; i <= static_cast<int>(CastType::Float2Float); ++i) {
+    auto type = static_cast<CastType>(i);
+    if (getInputDataType(type) == from && getOutputDataType(type) == to) {
+      return type;
+    }
+  }
+  return std::nullopt;
+}
+
+DataType CastObj::getOutputDataType(CastType type) {
+  switch (type) {
   case CastType::Float2Float16:
     return DataType::Float16;
   case CastType::Float2Int64:
@@ -0,0 +1,208 @@
+#include "core/rewriter.h"
+#include "operators/concat.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+namespace infini {
+
+namespace {
+// Casts that represent every input value exactly, so that the value can be
+// converted onwards as if it had not been cast.
+bool isExactCast(CastType type) {
+  switch (type) {
+  case CastType::Int322Int64:
+  case CastType::Int162Float:
+  case CastType::Int162Int32:
+  case CastType::Int82Float:
+  case CastType::Int82Int16:
+  case CastType::Int82Int32:
+  case CastType::Uint82Float:
+  case CastType::Uint82Int32:
+  case CastType::Uint82Int64:
+  case CastType::Uint322Int64:
+  case CastType::Float162Float:
+  case CastType::BFloat162Float:
+  case CastType::Float2Float:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Positive when the cast makes elements wider, negative when narrower.
+int widening(CastType type) {
+  auto from = CastObj::getInputDataType(type).getSize();
+  auto to = CastObj::getOutputDataType(type).getSize();
+  return from < to ? 1 : from > to ? -1 : 0;
+}
+
+// The single-use Cast producing `t`, if any.
+Ref<CastObj> singleUseCast(const Tensor &t) {
+  auto src = t->getSource();
+  if (!src || src->getOpType() != OpType::Cast ||
+      t->numTargets() != 1) {
+    return nullptr;
+  }
+  return as<CastObj>(src);
+}
+
+// Cast(Cast(x)) -> Cast(x) with the composed CastType, or x itself for a
+// round trip, when the first Cast is exact. Float2Float16 -> Float162Float
+// rounds and is kept. The first Cast is kept while it has other consumers.
+// A round trip ending in a graph output is folded into the producer of x.
+bool mergeCasts(GraphObj &graph, const OpVec &ops) {
+  auto src = as<CastObj>(ops[0]);
+  auto op = as<CastObj>(ops[1]);
+  auto root = src->getInputs(0);
+  auto in = op->getInputs(0);
+  auto out = op->getOutput();
+  if (!isExactCast(src->getType())) {
+    return false;
+  }
+  auto from = src->getInputDataType();
+  auto to = op->getOutputDataType();
+  auto type = CastObj::getCastType(from, to);
+  auto identity = from == to && !graph.isOutput(out);
+  auto producer = root->getSource();
+  if (from == to && !identity && producer &&
+      producer->getOutputs().size() == 1 && root->numTargets() == 1 &&
+      in->numTargets() == 1 && !graph.isOutput(root) &&
+      !graph.isOutput(in)) {
+    graph.eraseOperator(op);
+    graph.eraseOperator(src);
+    graph.eraseOperator(producer);
+    graph.pruneTensor(in);
+    graph.pruneTensor(root);
+    graph.addOpClone(producer, producer->getInputs(), {out});
+    return true;
+  }
+  if (!identity && !type) {
+    return false;
+  }
+
+  graph.eraseOperator(op);
+  if (identity) {
+    graph.replaceAllUses(out, root);
+    graph.pruneTensor(out);
+  } else {
+    graph.addOpWithOutputs<CastObj>(root, out, *type);
+  }
+  if (in->numTargets() == 0 && !graph.isOutput(in)) {
+    graph.eraseOperator(src);
+    graph.pruneTensor(in);
+  }
+  return true;
+}
+
+// A Cast to the type it reads, i.e. Float2Float, only copies its input. It is
+// kept when it produces a graph output.
+bool eraseIdentityCast(GraphObj &graph, const OpVec &ops) {
+  auto op = as<CastObj>(ops[0]);
+  auto out = op->getOutput();
+  if (!(op->getInputDataType() == op->getOutputDataType()) ||
+      graph.isOutput(out)) {
+    return false;
+  }
+  graph.eraseOperator(op);
+  graph.replaceAllUses(out, op->getInputs(0));
+  graph.pruneTensor(out);
+  return true;
+}
+
+// Cast(Transpose(x)) -> Transpose(Cast(x)) for a narrowing Cast, and
+// Transpose(Cast(x)) -> Cast(Transpose(x)) for a widening one, so that the
+// Transpose moves the narrower elements.
+bool swapCastTranspose(GraphObj &graph, const OpVec &ops) {
+  auto castFirst = ops[0]->getOpType() == OpType::Cast;
+  auto cast = as<CastObj>(ops[castFirst ? 0 : 1]);
+  auto transpose = as<TransposeObj>(ops[castFirst ? 1 : 0]);
+  if (widening(cast->getType()) != (castFirst ? 1 : -1)) {
+    return false;
+  }
+  auto in = ops[0]->getInputs(0);
+  auto value = ops[0]->getOutput();
+  auto out = ops[1]->getOutput();
+  graph.eraseOperator(ops[1]);
+  graph.eraseOperator(ops[0]);
+  graph.pruneTensor(value);
+  if (castFirst) {
+    auto mid = graph.addOp<TransposeObj>(in, nullptr, transpose->getPermute())
+                   ->getOutput();
+    graph.addOpWithOutputs<CastObj>(mid, out, cast->getType());
+  } else {
+    auto mid = graph.addOp<CastObj>(in, nullptr, cast->getType())->getOutput();
+    graph.addOpWithOutputs<TransposeObj>(mid, out, transpose->getPermute());
+  }
+  return true;
+}
+
+// Concat(Cast(x), Cast(y), ...) -> Cast(Concat(x, y, ...)) when the Casts
+// agree and do not narrow: one Cast instead of many, and the Concat copies
+// elements no wider than before.
+bool sinkCastsBelowConcat(GraphObj &graph, const OpVec &ops) {
+  auto concat = as<ConcatObj>(ops[0]);
+  vector<Ref<CastObj>> casts;
+  for (const auto &t : concat->getInputs()) {
+    auto cast = singleUseCast(t);
+    if (!cast || graph.isOutput(t) ||
+        (!casts.empty() && cast->getType() != casts[0]->getType())) {
+      return false;
+    }
+    casts.emplace_back(cast);
+  }
+  if (casts.empty() || widening(casts[0]->getType()) < 0) {
+    return false;
+  }
+
+  TensorVec inputs;
+  for (const auto &cast : casts) {
+    inputs.emplace_back(cast->getInputs(0));
+    graph.eraseOperator(cast);
+  }
+  graph.eraseOperator(concat);
+  for (const auto &cast : casts) {
+    graph.pruneTensor(cast->getOutput());
+  }
+  auto mid =
+      graph.addOp<ConcatObj>(inputs, nullptr, concat->getDim())->getOutput();
+  graph.addOpWithOutputs<CastObj>(mid, concat->getOutput(),
+                                  casts[0]->getType());
+  return true;
+}
+
+// Cast(Concat(x, y, ...)) -> Concat(Cast(x), Cast(y), ...) for a narrowing
+// Cast, so that the Concat copies the narrower elements.
+bool hoistCastAboveConcat(GraphObj &graph, const OpVec &ops) {
+  auto concat = as<ConcatObj>(ops[0]);
+  auto cast = as<CastObj>(ops[1]);
+  if (widening(cast->getType()) >= 0) {
+    return false;
+  }
+  TensorVec inputs;
+  for (const auto &t : concat->getInputs()) {
+    inputs.emplace_back(
+        graph.addOp<CastObj>(t, nullptr, cast->getType())->getOutput());
+  }
+  graph.eraseOperator(cast);
+  graph.eraseOperator(concat);
+  graph.pruneTensor(concat->getOutput());
+  graph.addOpWithOutputs<ConcatObj>(inputs, cast->getOutput(),
+                                    concat->getDim());
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"MergeCasts", 300, {OpType::Cast, OpType::Cast}, false,
+                  mergeCasts})
+REGISTER_REWRITE({"EraseIdentityCast", 300, {OpType::Cast}, false,
+                  eraseIdentityCast})
+REGISTER_REWRITE({"SinkCastBelowTranspose", 250,
+                  {OpType::Cast, OpType::Transpose}, true, swapCastTranspose})
+REGISTER_REWRITE({"HoistCastAboveTranspose", 250,
+                  {OpType::Transpose, OpType::Cast}, true, swapCastTranspose})
+REGISTER_REWRITE({"SinkCastsBelowConcat", 250, {OpType::Concat}, true,
+                  sinkCastsBelowConcat})
+REGISTER_REWRITE({"HoistCastAboveConcat", 250, {OpType::Concat, OpType::Cast},
+                  true, hoistCastAboveConcat})
+
+} // namespace infini
@@ -0,0 +1,53 @@
+#include "core/rewriter.h"
+
+namespace infini {
+
+namespace {
+// What an operator computes: its attributes and the guids of its inputs.
+using OpKey = std::pair<vector<int>, vector<UidBaseType>>;
+
+OpKey getOpKey(const Operator &op) {
+  vector<UidBaseType> inputs;
+  for (const auto &t : op->getInputs()) {
+    inputs.emplace_back(t->getGuid());
+  }
+  return {op->getOpAttrVector(), std::move(inputs)};
+}
+
+bool hasGraphOutput(const GraphObj &graph, const Operator &op) {
+  const auto &outputs = op->getOutputs();
+  return std::any_of(outputs.begin(), outputs.end(),
+                     [&](const Tensor &t) { return graph.isOutput(t); });
+}
+
+// Merge an operator with a duplicate reading the same first input: the
+// consumers of the duplicate read `op`'s outputs instead. A duplicate that
+// writes a graph output is kept.
+bool eliminateCommonSubexpression(GraphObj &graph, const OpVec &ops) {
+  auto op = ops[0];
+  if (op->getInputs().empty() || hasGraphOutput(graph, op)) {
+    return false;
+  }
+  // Equal operators read the same first input, so its consumers are the
+  // only candidates.
+  auto key = getOpKey(op);
+  for (const auto &other : op->getInputs(0)->getTargets()) {
+    if (other == op || other->getOpType() != op->getOpType() ||
+        hasGraphOutput(graph, other) || getOpKey(other) != key) {
+      continue;
+    }
+    graph.eraseOperator(other);
+    for (size_t i = 0; i < other->getOutputs().size(); ++i) {
+      graph.replaceAllUses(other->getOutput(i), op->getOutput(i));
+      graph.pruneTensor(other->getOutput(i));
+    }
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+REGISTER_REWRITE({"EliminateCommonSubexpression", 350, {OpType::Unknown}, true,
+                  eliminateCommonSubexpression})
+
+} // namespace infini
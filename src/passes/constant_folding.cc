@@ -0,0 +1,68 @@
+#include "core/kernel.h"
+#include "core/rewriter.h"
+
+namespace infini {
+
+namespace {
+// Evaluate an operator whose inputs are all constants with the CPU kernel
+// and turn its outputs into constants. Subgraphs fold one operator at a
+// time, and constants nothing reads any more are dropped.
+bool fold(GraphObj &graph, const Operator &op) {
+  const auto &inputs = op->getInputs();
+  const auto &outputs = op->getOutputs();
+  if (inputs.empty() ||
+      !std::all_of(inputs.begin(), inputs.end(),
+                   [](const Tensor &t) { return t->isConstant(); }) ||
+      // Graph outputs stay computed by an operator.
+      std::any_of(outputs.begin(), outputs.end(),
+                  [&](const Tensor &t) { return graph.isOutput(t); }) ||
+      !KernelRegistry::getInstance().hasKernel(
+          {Device::CPU, op->getOpType().underlying()})) {
+    return false;
+  }
+
+  // Run on the host copies, then give the tensors their blobs back in case
+  // the graph has already allocated memory.
+  TensorVec tensors(inputs);
+  for (const auto &t : outputs) {
+    t->setConstant();
+    tensors.emplace_back(t);
+  }
+  vector<Blob> blobs;
+  for (const auto &t : tensors) {
+    blobs.emplace_back(t->getDataBlob());
+    t->setDataBlob(t->getConstantBlob());
+  }
+  NativeCpuRuntimeObj::getInstance()->runOp(op);
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    tensors[i]->setDataBlob(blobs[i]);
+    if (blobs[i] && i >= inputs.size()) {
+      tensors[i]->loadConstant();
+    }
+  }
+
+  graph.eraseOperator(op);
+  for (const auto &t : inputs) {
+    graph.pruneTensor(t);
+  }
+  return true;
+}
+
+// DequantizeLinear waits for foldDequantize: folded early, it would widen
+// Int8 weights back to Float32 and hide them from QuantizeMatmul.
+bool foldConstant(GraphObj &graph, const OpVec &ops) {
+  return ops[0]->getOpType() != OpType::DequantizeLinear &&
+         fold(graph, ops[0]);
+}
+
+// The dequantized constants QuantizeMatmul has left, e.g. biases.
+bool foldDequantize(GraphObj &graph, const OpVec &ops) {
+  return fold(graph, ops[0]);
+}
+} // namespace
+
+REGISTER_REWRITE({"FoldConstant", 400, {OpType::Unknown}, true, foldConstant})
+REGISTER_REWRITE({"FoldDequantize", 170, {OpType::DequantizeLinear}, true,
+                  foldDequantize})
+
+} // namespace infini
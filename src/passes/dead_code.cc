@@ -0,0 +1,30 @@
+#include "core/rewriter.h"
+
+namespace infini {
+
+namespace {
+// Erase an operator whose outputs are neither read nor graph outputs, with
+// the tensors nothing else uses. Dead branches go away from their ends
+// backwards, leaving what the marked outputs depend on.
+bool eraseDeadOperator(GraphObj &graph, const OpVec &ops) {
+  auto op = ops[0];
+  for (const auto &t : op->getOutputs()) {
+    if (t->numTargets() != 0 || graph.isOutput(t)) {
+      return false;
+    }
+  }
+  graph.eraseOperator(op);
+  for (const auto &t : op->getOutputs()) {
+    graph.pruneTensor(t);
+  }
+  for (const auto &t : op->getInputs()) {
+    graph.pruneTensor(t);
+  }
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"EraseDeadOperator", 500, {OpType::Unknown}, true,
+                  eraseDeadOperator})
+
+} // namespace infini
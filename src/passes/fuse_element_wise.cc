@@ -0,0 +1,124 @@
+#include "core/rewriter.h"
+#include "operators/fused_element_wise.h"
+#include "operators/unary.h"
+
+namespace infini {
+
+namespace {
+struct Chain {
+  TensorVec inputs;
+  vector<FusedStep> steps;
+};
+
+// `op` as a fused chain whose running value starts at `value`, or at its
+// first input if `value` is null. Fails if the chain would also need `value`
+// as an operand, which is no longer available once the producer is fused.
+optional<Chain> asChain(const Operator &op, const Tensor &value) {
+  auto type = op->getOpType();
+  if (type == OpType::FusedElementWise) {
+    auto inputs = op->getInputs();
+    auto steps = as<FusedElementWiseObj>(op)->getSteps();
+    if (!value) {
+      return Chain{inputs, steps};
+    }
+    if (inputs[0] != value) {
+      // Re-root the chain when `value` is the operand of its first step:
+      // `s op value` becomes `value op' s`.
+      auto k = static_cast<int>(
+          std::find(inputs.begin(), inputs.end(), value) - inputs.begin());
+      if (k == static_cast<int>(inputs.size()) || steps[0].operand != k) {
+        return std::nullopt;
+      }
+      std::swap(inputs[0], inputs[k]);
+      steps[0].operandFirst = !steps[0].operandFirst;
+      for (size_t i = 1; i < steps.size(); ++i) {
+        if (steps[i].operand == 0) {
+          steps[i].operand = k;
+        } else if (steps[i].operand == k) {
+          steps[i].operand = 0;
+        }
+      }
+    }
+    if (std::any_of(steps.begin(), steps.end(),
+                    [](const auto &s) { return s.operand == 0; })) {
+      return std::nullopt;
+    }
+    return Chain{inputs, steps};
+  }
+  if (!FusedElementWiseObj::isFusible(type)) {
+    return std::nullopt;
+  }
+
+  FusedStep step{type};
+  if (op->numInputs() == 2) {
+    auto a = op->getInputs(0);
+    auto b = op->getInputs(1);
+    if (value && (a == value) == (b == value)) {
+      return std::nullopt;
+    }
+    if (value && b == value) {
+      std::swap(a, b);
+      step.operandFirst = true;
+    }
+    step.operand = a == b ? 0 : 1;
+    return Chain{a == b ? TensorVec{a} : TensorVec{a, b}, {step}};
+  }
+  if (value && op->getInputs(0) != value) {
+    return std::nullopt;
+  }
+  if (type == OpType::Clip) {
+    auto clip = as<ClipObj>(op);
+    step.min = clip->getMin();
+    step.max = clip->getMax();
+  }
+  return Chain{{op->getInputs(0)}, {step}};
+}
+
+// Merge an element-wise producer into its only consumer. Chains of any length
+// collapse into one FusedElementWise a link at a time.
+bool fuseElementWise(GraphObj &graph, const OpVec &ops) {
+  auto producer = ops[0];
+  auto consumer = ops[1];
+  if (!(producer->getDType() == consumer->getDType())) {
+    return false;
+  }
+  auto head = asChain(producer, nullptr);
+  if (!head) {
+    return false;
+  }
+  auto value = producer->getOutput();
+  auto tail = asChain(consumer, value);
+  if (!tail) {
+    return false;
+  }
+
+  auto inputs = std::move(head->inputs);
+  auto steps = std::move(head->steps);
+  auto operandIndex = [&inputs](const Tensor &t) {
+    auto it = std::find(inputs.begin(), inputs.end(), t);
+    if (it == inputs.end()) {
+      inputs.emplace_back(t);
+      return static_cast<int>(inputs.size() - 1);
+    }
+    return static_cast<int>(it - inputs.begin());
+  };
+  for (auto step : tail->steps) {
+    if (step.operand >= 0) {
+      step.operand = operandIndex(tail->inputs[step.operand]);
+    }
+    steps.emplace_back(step);
+  }
+
+  graph.eraseOperator(producer);
+  graph.eraseOperator(consumer);
+  graph.pruneTensor(value);
+  graph.addOpWithOutputs<FusedElementWiseObj>(inputs, consumer->getOutput(),
+                                              steps);
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"FuseElementWise", 50, {OpType::Unknown, OpType::Unknown},
+                  true, fuseElementWise})
+
+} // namespace infini
@@ -0,0 +1,98 @@
+#include "core/rewriter.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+#include "utils/operator_utils.h"
+
+namespace infini {
+
+namespace {
+// A constant that broadcasts like a scalar, or nullopt.
+optional<float> constantScalar(const Tensor &t) {
+  if (!t->isConstant() || t->size() != 1 ||
+      !(t->getDType() == DataType::Float32)) {
+    return std::nullopt;
+  }
+  return *t->getConstantBlob()->getPtr<float *>();
+}
+
+// Fold the only consumer of a MatMul into its epilogue: an Add or Sub of a
+// broadcast bias or residual (before any clamp), a Mul by a constant scalar
+// (before any clamp), Relu or Clip. Longer chains fold one link at a time.
+bool foldMatmulEpilogue(GraphObj &graph, const OpVec &ops) {
+  auto matmul = as<MatmulObj>(ops[0]);
+  auto next = ops[1];
+  if (!(next->getDType() == matmul->getDType())) {
+    return false;
+  }
+  auto out = matmul->getOutput();
+  auto bias = matmul->getBias();
+  auto epilogue = matmul->getEpilogue();
+  auto type = next->getOpType();
+  if (type == OpType::Add || type == OpType::Sub || type == OpType::Mul) {
+    auto outFirst = next->getInputs(0) == out;
+    auto other = next->getInputs(outFirst ? 1 : 0);
+    // The output keeps the MatMul's shape, so `other` must not widen it.
+    if (epilogue.hasClamp() || other == out ||
+        (type != OpType::Add &&
+         !(matmul->getDType() == DataType::Float32)) ||
+        infer_broadcast(out->getDims(), other->getDims()) != out->getDims()) {
+      return false;
+    }
+    if (type == OpType::Mul) {
+      auto scale = constantScalar(other);
+      if (!scale) {
+        return false;
+      }
+      epilogue.alpha *= *scale;
+      epilogue.beta *= *scale;
+    } else {
+      if (bias) {
+        return false;
+      }
+      bias = other;
+      // other - alpha * acc
+      if (type == OpType::Sub && !outFirst) {
+        epilogue.alpha = -epilogue.alpha;
+      }
+      // alpha * acc - other
+      epilogue.beta = type == OpType::Sub && outFirst ? -1.f : 1.f;
+    }
+  } else if (type == OpType::Relu) {
+    if (!epilogue.composeClamp(0.f, std::nullopt)) {
+      return false;
+    }
+  } else if (type == OpType::Clip) {
+    auto clip = as<ClipObj>(next);
+    if (!epilogue.composeClamp(clip->getMin(), clip->getMax())) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  graph.eraseOperator(matmul);
+  graph.eraseOperator(next);
+  graph.pruneTensor(out);
+  graph.addOpWithOutputs<MatmulObj>(matmul->getInputs(0), matmul->getInputs(1),
+                                    next->getOutput(), matmul->getTransA(),
+                                    matmul->getTransB(), bias, epilogue);
+  // A folded scale is no longer read.
+  for (const auto &t : next->getInputs()) {
+    graph.pruneTensor(t);
+  }
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"FoldMatmulBias", 100, {OpType::MatMul, OpType::Add}, true,
+                  foldMatmulEpilogue})
+REGISTER_REWRITE({"FoldMatmulSub", 100, {OpType::MatMul, OpType::Sub}, true,
+                  foldMatmulEpilogue})
+REGISTER_REWRITE({"FoldMatmulScale", 100, {OpType::MatMul, OpType::Mul}, true,
+                  foldMatmulEpilogue})
+REGISTER_REWRITE({"FoldMatmulRelu", 100, {OpType::MatMul, OpType::Relu}, true,
+                  foldMatmulEpilogue})
+REGISTER_REWRITE({"FoldMatmulClip", 100, {OpType::MatMul, OpType::Clip}, true,
+                  foldMatmulEpilogue})
+
+} // namespace infini
@@ -0,0 +1,105 @@
+#include "core/rewriter.h"
+#include "operators/concat.h"
+#include "operators/matmul.h"
+
+namespace infini {
+
+namespace {
+bool sameEpilogue(const MatmulEpilogue &a, const MatmulEpilogue &b) {
+  return a.alpha == b.alpha && a.beta == b.beta && a.min == b.min &&
+         a.max == b.max;
+}
+
+// A constant bias that only varies along the last dimension of `out`.
+bool isColumnBias(const Tensor &bias, const Tensor &out) {
+  if (!bias->isConstant() || bias->getRank() == 0) {
+    return false;
+  }
+  auto dims = bias->getDims();
+  return dims.back() == out->getDims().back() &&
+         std::all_of(dims.begin(), dims.end() - 1, [](int d) { return d == 1; });
+}
+
+// Concat(MatMul(A, B1), MatMul(A, B2), ...) along the last dimension ->
+// MatMul(A, Concat(B1, B2, ...)). Only constant weights are merged, so that
+// FoldConstant concatenates them once; constant column biases are merged the
+// same way.
+bool mergeConcatMatmuls(GraphObj &graph, const OpVec &ops) {
+  auto concat = as<ConcatObj>(ops[0]);
+  const auto &inputs = concat->getInputs();
+  auto rank = concat->getOutput()->getRank();
+  if (inputs.size() < 2 || concat->getDim() != static_cast<int>(rank) - 1) {
+    return false;
+  }
+
+  vector<Ref<MatmulObj>> matmuls;
+  for (const auto &t : inputs) {
+    auto src = t->getSource();
+    if (!src || src->getOpType() != OpType::MatMul ||
+        t->numTargets() != 1 || graph.isOutput(t)) {
+      return false;
+    }
+    matmuls.emplace_back(as<MatmulObj>(src));
+  }
+  const auto &first = matmuls[0];
+  auto hasBias = first->getBias() != nullptr;
+  auto weightRank = first->getInputs(1)->getRank();
+  // The output columns of B are its last dimension, or the one before it
+  // when B is transposed.
+  auto weightDim = static_cast<int>(weightRank) - (first->getTransB() ? 2 : 1);
+  // Weights must only differ in their output columns.
+  auto sameShape = [&](const Tensor &t) {
+    auto dims = t->getDims();
+    auto expected = first->getInputs(1)->getDims();
+    dims[weightDim] = expected[weightDim];
+    return dims == expected;
+  };
+  for (const auto &matmul : matmuls) {
+    const auto &weight = matmul->getInputs(1);
+    if (matmul->getInputs(0) != first->getInputs(0) ||
+        matmul->getTransA() != first->getTransA() ||
+        matmul->getTransB() != first->getTransB() ||
+        !sameEpilogue(matmul->getEpilogue(), first->getEpilogue()) ||
+        !weight->isConstant() || weight->getRank() != weightRank ||
+        !sameShape(weight) ||
+        (matmul->getBias() != nullptr) != hasBias ||
+        (hasBias &&
+         (!isColumnBias(matmul->getBias(), matmul->getOutput()) ||
+          matmul->getBias()->getRank() != first->getBias()->getRank()))) {
+      return false;
+    }
+  }
+
+  TensorVec weights;
+  TensorVec biases;
+  for (const auto &matmul : matmuls) {
+    weights.emplace_back(matmul->getInputs(1));
+    if (hasBias) {
+      biases.emplace_back(matmul->getBias());
+    }
+  }
+  auto weight =
+      graph.addOp<ConcatObj>(weights, nullptr, weightDim)->getOutput();
+  Tensor bias;
+  if (hasBias) {
+    auto biasDim = static_cast<int>(biases[0]->getRank()) - 1;
+    bias = graph.addOp<ConcatObj>(biases, nullptr, biasDim)->getOutput();
+  }
+  for (const auto &matmul : matmuls) {
+    graph.eraseOperator(matmul);
+  }
+  graph.eraseOperator(concat);
+  for (const auto &matmul : matmuls) {
+    graph.pruneTensor(matmul->getOutput());
+  }
+  graph.addOpWithOutputs<MatmulObj>(
+      first->getInputs(0), weight, concat->getOutput(), first->getTransA(),
+      first->getTransB(), bias, first->getEpilogue());
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"MergeConcatMatmuls", 150, {OpType::Concat}, true,
+                  mergeConcatMatmuls})
+
+} // namespace infini
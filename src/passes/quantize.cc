@@ -0,0 +1,113 @@
+#include "core/rewriter.h"
+#include "operators/matmul.h"
+#include "operators/quantize.h"
+#include <algorithm>
+
+namespace infini {
+
+namespace {
+// No zero point, or a constant one of zeros.
+bool isZero(const Tensor &zeroPoint) {
+  if (!zeroPoint) {
+    return true;
+  }
+  if (!zeroPoint->isConstant()) {
+    return false;
+  }
+  auto *ptr = zeroPoint->getConstantBlob()->getPtr<uint8_t *>();
+  return std::all_of(ptr, ptr + zeroPoint->getBytes(),
+                     [](uint8_t b) { return b == 0; });
+}
+
+// The DequantizeLinear producing `t` from Int8 values with a constant scale
+// and no offset, if any.
+Ref<DequantizeLinearObj> symmetricInt8Source(const Tensor &t) {
+  auto src = t->getSource();
+  if (!src || src->getOpType() != OpType::DequantizeLinear) {
+    return nullptr;
+  }
+  auto dq = as<DequantizeLinearObj>(src);
+  if (!(dq->getDType() == DataType::Int8) || !dq->getScale()->isConstant() ||
+      !isZero(dq->getZeroPoint())) {
+    return nullptr;
+  }
+  return dq;
+}
+
+// If only `op` reads `t`.
+bool onlyReadBy(GraphObj &graph, const Tensor &t, const Operator &op) {
+  auto targets = t->getTargets();
+  return !graph.isOutput(t) &&
+         std::all_of(targets.begin(), targets.end(),
+                     [&](const Operator &o) { return o == op; });
+}
+
+void eraseDequantize(GraphObj &graph, const Ref<DequantizeLinearObj> &dq) {
+  graph.eraseOperator(dq);
+  for (const auto &t : dq->getInputs()) {
+    graph.pruneTensor(t);
+  }
+  graph.pruneTensor(dq->getOutput());
+}
+
+// MatMul(DequantizeLinear(a), DequantizeLinear(b)) ->
+// DequantizeLinear(MatMul(a, b)) for symmetric Int8 a and b: the Int8 product
+// accumulates in Int32, and the scales multiply. a needs one scale, b one or
+// one per output column.
+bool quantizeMatmul(GraphObj &graph, const OpVec &ops) {
+  auto matmul = as<MatmulObj>(ops[1]);
+  const auto &epilogue = matmul->getEpilogue();
+  if (matmul->getBias() || !(matmul->getDType() == DataType::Float32) ||
+      epilogue.alpha != 1.f || epilogue.hasClamp()) {
+    return false;
+  }
+  auto dqA = symmetricInt8Source(matmul->getInputs(0));
+  auto dqB = symmetricInt8Source(matmul->getInputs(1));
+  if (!dqA || !dqB || dqA->isPerChannel()) {
+    return false;
+  }
+  const auto &b = dqB->getInputs(0);
+  auto bRank = static_cast<int>(b->getRank());
+  auto columnAxis = bRank - (matmul->getTransB() ? 2 : 1);
+  // The Int8 kernel reads an unbatched B.
+  if ((dqB->isPerChannel() && dqB->getAxis() != columnAxis) ||
+      std::any_of(b->getDims().begin(), b->getDims().end() - 2,
+                  [](int d) { return d != 1; })) {
+    return false;
+  }
+
+  auto scaleA = dqA->getScale();
+  auto scaleB = dqB->getScale();
+  auto scale = graph.addTensor(scaleB->getDims(), DataType::Float32);
+  scale->setConstant([&](void *ptr, size_t size, DataType) {
+    auto a = *scaleA->getConstantBlob()->getPtr<float *>();
+    auto *src = scaleB->getConstantBlob()->getPtr<float *>();
+    auto *dst = static_cast<float *>(ptr);
+    for (size_t i = 0; i < size; ++i) {
+      dst[i] = a * src[i];
+    }
+  });
+  auto deadA = onlyReadBy(graph, matmul->getInputs(0), matmul);
+  auto deadB = dqB != dqA && onlyReadBy(graph, matmul->getInputs(1), matmul);
+  auto out = matmul->getOutput();
+  graph.eraseOperator(matmul);
+  auto acc = graph
+                 .addOp<MatmulObj>(dqA->getInputs(0), b, nullptr,
+                                   matmul->getTransA(), matmul->getTransB())
+                 ->getOutput();
+  graph.addOpWithOutputs<DequantizeLinearObj>(acc, scale, nullptr, out, -1);
+  if (deadA) {
+    eraseDequantize(graph, dqA);
+  }
+  if (deadB) {
+    eraseDequantize(graph, dqB);
+  }
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"QuantizeMatmul", 175,
+                  {OpType::DequantizeLinear, OpType::MatMul}, false,
+                  quantizeMatmul})
+
+} // namespace infini
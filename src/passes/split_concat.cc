@@ -0,0 +1,73 @@
+#include "core/rewriter.h"
+#include "operators/concat.h"
+#include "operators/split.h"
+#include <algorithm>
+
+namespace infini {
+
+namespace {
+// Concat(Split(x)) -> x when the Concat joins all outputs of the Split in
+// order along the split dimension. The Split is erased once nothing else reads
+// its outputs.
+bool cancelSplitConcat(GraphObj &graph, const OpVec &ops) {
+  auto split = as<SplitObj>(ops[0]);
+  auto concat = as<ConcatObj>(ops[1]);
+  const auto &parts = split->getOutputs();
+  auto out = concat->getOutput();
+  if (concat->getInputs() != parts || concat->getDim() != split->getDim() ||
+      graph.isOutput(out)) {
+    return false;
+  }
+  auto splitDead = std::all_of(parts.begin(), parts.end(), [&](const Tensor &t) {
+    return t->numTargets() == 1 && !graph.isOutput(t);
+  });
+  graph.eraseOperator(concat);
+  graph.replaceAllUses(out, split->getInputs(0));
+  graph.pruneTensor(out);
+  if (splitDead) {
+    graph.eraseOperator(split);
+    for (const auto &t : parts) {
+      graph.pruneTensor(t);
+    }
+  }
+  return true;
+}
+
+// Split(Concat(x, y, ...)) -> x, y, ... when the Split cuts along the
+// concatenated dimension where the Concat joined. The Concat is erased once
+// nothing else reads its output.
+bool cancelConcatSplit(GraphObj &graph, const OpVec &ops) {
+  auto concat = as<ConcatObj>(ops[0]);
+  auto split = as<SplitObj>(ops[1]);
+  const auto &inputs = concat->getInputs();
+  const auto &parts = split->getOutputs();
+  if (concat->getDim() != split->getDim() || inputs.size() != parts.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < parts.size(); ++i) {
+    if (inputs[i]->getDims() != parts[i]->getDims() ||
+        graph.isOutput(parts[i])) {
+      return false;
+    }
+  }
+  auto mid = concat->getOutput();
+  auto concatDead = mid->numTargets() == 1 && !graph.isOutput(mid);
+  graph.eraseOperator(split);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    graph.replaceAllUses(parts[i], inputs[i]);
+    graph.pruneTensor(parts[i]);
+  }
+  if (concatDead) {
+    graph.eraseOperator(concat);
+    graph.pruneTensor(mid);
+  }
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"CancelSplitConcat", 300, {OpType::Split, OpType::Concat},
+                  false, cancelSplitConcat})
+REGISTER_REWRITE({"CancelConcatSplit", 300, {OpType::Concat, OpType::Split},
+                  false, cancelConcatSplit})
+
+} // namespace infini
@@ -0,0 +1,318 @@
+#include "core/rewriter.h"
+#include "operators/matmul.h"
+#include "operators/transpose.h"
+
+namespace infini {
+
+namespace {
+bool isIdentityPermute(const vector<int> &perm) {
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (perm[i] != static_cast<int>(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Only swaps the last two dimensions, i.e. what MatMul's trans flags do.
+bool isLastTwoSwap(const vector<int> &perm) {
+  auto rank = perm.size();
+  if (rank < 2) {
+    return false;
+  }
+  for (size_t i = 0; i + 2 < rank; ++i) {
+    if (perm[i] != static_cast<int>(i)) {
+      return false;
+    }
+  }
+  return perm[rank - 2] == static_cast<int>(rank - 1) &&
+         perm[rank - 1] == static_cast<int>(rank - 2);
+}
+
+vector<int> inversePermute(const vector<int> &perm) {
+  vector<int> inv(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i) {
+    inv[perm[i]] = static_cast<int>(i);
+  }
+  return inv;
+}
+
+// Operators a Transpose can move through without changing the result.
+bool isLayoutAgnostic(OpType type) {
+  switch (type.underlying()) {
+  case OpType::Add:
+  case OpType::Sub:
+  case OpType::Mul:
+  case OpType::Div:
+  case OpType::Relu:
+  case OpType::Clip:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// What `perm` does to the last `rank` dimensions of a broadcast operand, if it
+// keeps the leading dimensions in place.
+optional<vector<int>> trailingPermute(const vector<int> &perm, size_t rank) {
+  auto offset = static_cast<int>(perm.size() - rank);
+  for (int i = 0; i < offset; ++i) {
+    if (perm[i] != i) {
+      return std::nullopt;
+    }
+  }
+  vector<int> ret;
+  for (auto i = perm.begin() + offset; i != perm.end(); ++i) {
+    ret.emplace_back(*i - offset);
+  }
+  return ret;
+}
+
+// The Transpose producing `t`, if `t` has no other consumer.
+Ref<TransposeObj> singleUseTranspose(const Tensor &t) {
+  auto src = t->getSource();
+  if (!src || src->getOpType() != OpType::Transpose ||
+      t->numTargets() != 1) {
+    return nullptr;
+  }
+  return as<TransposeObj>(src);
+}
+
+// Transposes of operands the size of `out` are what moving a Transpose
+// trades; the ones of smaller broadcast operands are treated as free.
+int countTranspose(const Tensor &t, const Tensor &out) {
+  return t->size() == out->size() && singleUseTranspose(t) ? 1 : 0;
+}
+
+// Transposes left on operand `t` of an element-wise op writing `out` after
+// permuting it by `perm`, or nullopt if it cannot be permuted.
+optional<int> permuteCost(const Tensor &t, const Tensor &out,
+                          const vector<int> &perm) {
+  auto dims = t->getDims();
+  if (std::all_of(dims.begin(), dims.end(), [](int d) { return d == 1; })) {
+    return 0;
+  }
+  auto sub = trailingPermute(perm, t->getRank());
+  if (!sub) {
+    return std::nullopt;
+  }
+  if (isIdentityPermute(*sub) || t->size() != out->size()) {
+    return 0;
+  }
+  if (auto src = singleUseTranspose(t)) {
+    auto composed = *sub;
+    for (auto &p : composed) {
+      p = src->getPermute()[p];
+    }
+    if (isIdentityPermute(composed)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// `t` permuted by `perm`, through a new Transpose unless that is a no-op.
+// Transposes that cancel are removed by MergeTransposes.
+Tensor permuteOperand(GraphObj &graph, const Tensor &t,
+                      const vector<int> &perm) {
+  auto dims = t->getDims();
+  auto sub = *trailingPermute(perm, t->getRank());
+  if (std::all_of(dims.begin(), dims.end(), [](int d) { return d == 1; }) ||
+      isIdentityPermute(sub)) {
+    return t;
+  }
+  return graph.addOp<TransposeObj>(t, nullptr, sub)->getOutput();
+}
+
+// Whether a Transpose by `perm` written to `t` would meet another Transpose,
+// or a MatMul that can fold it, through single-consumer layout-agnostic
+// operators.
+bool reachesTransposeSink(Tensor t, const vector<int> &perm) {
+  while (true) {
+    auto targets = t->getTargets();
+    if (targets.size() != 1) {
+      return false;
+    }
+    const auto &next = targets[0];
+    auto type = next->getOpType();
+    if (type == OpType::Transpose) {
+      return true;
+    }
+    if (type == OpType::MatMul) {
+      return isLastTwoSwap(perm) && as<MatmulObj>(next)->getBias() != t;
+    }
+    if (!isLayoutAgnostic(type) ||
+        next->getOutput()->getRank() != perm.size()) {
+      return false;
+    }
+    t = next->getOutput();
+  }
+}
+
+// E(Transpose(x), y) -> Transpose(E(x, Transpose'(y))) for a layout-agnostic
+// E. Moves down when it removes full-size transposes, or on the way to a
+// Transpose or MatMul that absorbs it.
+bool sinkTranspose(GraphObj &graph, const OpVec &ops) {
+  auto transpose = as<TransposeObj>(ops[0]);
+  auto op = ops[1];
+  if (!isLayoutAgnostic(op->getOpType())) {
+    return false;
+  }
+  auto in = transpose->getInputs(0);
+  auto value = transpose->getOutput();
+  auto out = op->getOutput();
+  const auto &perm = transpose->getPermute();
+  if (out->getRank() != perm.size() || value->getDims() != out->getDims()) {
+    return false;
+  }
+  auto inv = inversePermute(perm);
+  auto before = 0;
+  auto after = 1;
+  for (const auto &t : op->getInputs()) {
+    auto cost = permuteCost(t, out, inv);
+    if (!cost) {
+      return false;
+    }
+    before += countTranspose(t, out);
+    after += *cost;
+  }
+  if (after > before ||
+      (after == before && !reachesTransposeSink(out, perm))) {
+    return false;
+  }
+
+  TensorVec inputs;
+  for (const auto &t : op->getInputs()) {
+    inputs.emplace_back(t == value ? in : permuteOperand(graph, t, inv));
+  }
+  auto dims = in->getDims();
+  graph.eraseOperator(op);
+  graph.eraseOperator(transpose);
+  graph.pruneTensor(value);
+  auto mid = graph.addTensor(dims, out->getDType());
+  graph.addOpClone(op, inputs, {mid});
+  graph.addOpWithOutputs<TransposeObj>(mid, out, perm);
+  return true;
+}
+
+// Transpose(E(x, y)) -> E(Transpose(x), Transpose(y)) when that removes
+// full-size transposes, i.e. when those on the operands cancel.
+bool hoistTranspose(GraphObj &graph, const OpVec &ops) {
+  auto op = ops[0];
+  auto transpose = as<TransposeObj>(ops[1]);
+  if (!isLayoutAgnostic(op->getOpType())) {
+    return false;
+  }
+  auto value = op->getOutput();
+  const auto &perm = transpose->getPermute();
+  auto before = 1;
+  auto after = 0;
+  for (const auto &t : op->getInputs()) {
+    auto cost = permuteCost(t, value, perm);
+    if (!cost) {
+      return false;
+    }
+    before += countTranspose(t, value);
+    after += *cost;
+  }
+  if (after >= before) {
+    return false;
+  }
+
+  TensorVec inputs;
+  for (const auto &t : op->getInputs()) {
+    inputs.emplace_back(permuteOperand(graph, t, perm));
+  }
+  graph.eraseOperator(op);
+  graph.eraseOperator(transpose);
+  graph.pruneTensor(value);
+  graph.addOpClone(op, inputs, {transpose->getOutput()});
+  return true;
+}
+
+// Transpose(Transpose(x)) -> Transpose(x) with the composed permutation, or x
+// itself when the composition is the identity. The first Transpose is kept
+// while it has other consumers.
+bool mergeTransposes(GraphObj &graph, const OpVec &ops) {
+  auto src = ops[0];
+  auto op = ops[1];
+  auto root = src->getInputs(0);
+  auto in = op->getInputs(0);
+  auto out = op->getOutput();
+  // out[i] = in[perm[i]] = root[srcPerm[perm[i]]]
+  auto perm = as<TransposeObj>(op)->getPermute();
+  const auto &srcPerm = as<TransposeObj>(src)->getPermute();
+  for (auto &p : perm) {
+    p = srcPerm[p];
+  }
+
+  graph.eraseOperator(op);
+  if (isIdentityPermute(perm) && !graph.isOutput(out)) {
+    graph.replaceAllUses(out, root);
+    graph.pruneTensor(out);
+  } else {
+    graph.addOpWithOutputs<TransposeObj>(root, out, perm);
+  }
+  if (in->numTargets() == 0 && !graph.isOutput(in)) {
+    graph.eraseOperator(src);
+    graph.pruneTensor(in);
+  }
+  return true;
+}
+
+// A Transpose with the identity permutation only copies its input. It is
+// kept when it produces a graph output.
+bool eraseIdentityTranspose(GraphObj &graph, const OpVec &ops) {
+  auto op = ops[0];
+  auto out = op->getOutput();
+  if (!isIdentityPermute(as<TransposeObj>(op)->getPermute()) ||
+      graph.isOutput(out)) {
+    return false;
+  }
+  graph.eraseOperator(op);
+  graph.replaceAllUses(out, op->getInputs(0));
+  graph.pruneTensor(out);
+  return true;
+}
+
+// Flip transA / transB of a MatMul reading a Transpose of its last two
+// dimensions. The Transpose goes away with its last consumer.
+bool foldTransposeIntoMatmul(GraphObj &graph, const OpVec &ops) {
+  auto op = ops[0];
+  auto matmul = as<MatmulObj>(ops[1]);
+  auto in = op->getInputs(0);
+  auto out = op->getOutput();
+  if (!isLastTwoSwap(as<TransposeObj>(op)->getPermute()) ||
+      matmul->getBias() == out) {
+    return false;
+  }
+  if (matmul->getInputs(0) == out) {
+    matmul->setTransA(!matmul->getTransA());
+  }
+  if (matmul->getInputs(1) == out) {
+    matmul->setTransB(!matmul->getTransB());
+  }
+  graph.replaceOpInput(matmul, out, in);
+  // Refresh m, n, k for the new trans flags.
+  IT_ASSERT(matmul->checkValid(nullptr));
+  if (out->numTargets() == 0 && !graph.isOutput(out)) {
+    graph.eraseOperator(op);
+    graph.pruneTensor(out);
+  }
+  return true;
+}
+} // namespace
+
+REGISTER_REWRITE({"MergeTransposes", 300, {OpType::Transpose, OpType::Transpose},
+                  false, mergeTransposes})
+REGISTER_REWRITE({"EraseIdentityTranspose", 300, {OpType::Transpose}, false,
+                  eraseIdentityTranspose})
+REGISTER_REWRITE({"SinkTranspose", 250, {OpType::Transpose, OpType::Unknown},
+                  true, sinkTranspose})
+REGISTER_REWRITE({"HoistTranspose", 250, {OpType::Unknown, OpType::Transpose},
+                  true, hoistTranspose})
+REGISTER_REWRITE({"FoldTransposeIntoMatmul", 200,
+                  {OpType::Transpose, OpType::MatMul}, false,
+                  foldTransposeIntoMatmul})
+
+} // namespace infini
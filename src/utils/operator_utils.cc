@@ -1,5 +1,7 @@
 #include "utils/operator_utils.h"
 #include "core/runtime.h"
+#include <algorithm>
+#include <cstring>
 
 namespace infini {
 
@@ -46,24 +48,82 @@ Shape locate_index(size_t inputN, const Shape &shape) {
   auto j = shape.rbegin();
   auto ej = shape.rend();
   while (j != ej) {
-    auto div = std::div(static_cast<int>(inputN), *j++);
-    *i++ = div.rem;
-    inputN = div.quot;
+    auto dim = static_cast<size_t>(*j++);
+    *i++ = static_cast<ShapeElem>(inputN % dim);
+    inputN /= dim;
   }
   return ans;
 }
 
 size_t delocate_index(const Shape &shapeIndex, const Shape &shape,
-                      const Shape &stride) {
-  size_t ans = 0;
-  Shape index(shapeIndex.size());
+                      const Strides &stride) {
+  int64_t ans = 0;
   IT_ASSERT(shapeIndex.size() == shape.size());
   IT_ASSERT(shape.size() == stride.size());
   for (size_t i = 0; i < shape.size(); ++i) {
-    index[i] = shapeIndex[i] % shape[i];
-    ans += static_cast<long>(index[i]) * stride[i];
+    ans += (shapeIndex[i] % shape[i]) * stride[i];
   }
-  return ans;
+  return static_cast<size_t>(ans);
+}
+
+Strides broadcast_strides(const Tensor &tensor, size_t rank) {
+  const auto &dims = tensor->getDims();
+  const auto &strides = tensor->getStrides();
+  IT_ASSERT(dims.size() <= rank);
+  Strides ret(rank, 0);
+  auto offset = rank - dims.size();
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (dims[i] != 1) {
+      ret[offset + i] = strides[i];
+    }
+  }
+  return ret;
+}
+
+void copy_strided(uint8_t *dst, const Strides &dstStrides, const uint8_t *src,
+                  const Strides &srcStrides, const Shape &dims,
+                  size_t elemSize) {
+  IT_ASSERT(dstStrides.size() == dims.size() &&
+            srcStrides.size() == dims.size());
+  if (std::find(dims.begin(), dims.end(), 0) != dims.end()) {
+    return;
+  }
+  // Merge the trailing dimensions that both layouts keep contiguous.
+  auto outer = dims.size();
+  int64_t run = 1;
+  while (outer > 0 &&
+         (dims[outer - 1] == 1 ||
+          (dstStrides[outer - 1] == run && srcStrides[outer - 1] == run))) {
+    run *= dims[outer - 1];
+    --outer;
+  }
+  size_t count = 1;
+  for (size_t i = 0; i < outer; ++i) {
+    count *= dims[i];
+  }
+  auto bytes = run * elemSize;
+#pragma omp parallel for
+  for (size_t n = 0; n < count; ++n) {
+    auto rest = n;
+    int64_t dstIdx = 0;
+    int64_t srcIdx = 0;
+    for (auto d = outer; d > 0; --d) {
+      auto idx = static_cast<int64_t>(rest % dims[d - 1]);
+      rest /= dims[d - 1];
+      dstIdx += idx * dstStrides[d - 1];
+      srcIdx += idx * srcStrides[d - 1];
+    }
+    std::memcpy(dst + dstIdx * elemSize, src + srcIdx * elemSize, bytes);
+  }
+}
+
+void append_attr(vector<int> &attrs, const optional<float> &value) {
+  attrs.emplace_back(value.has_value());
+  int bits = 0;
+  if (value) {
+    std::memcpy(&bits, &*value, sizeof(bits));
+  }
+  attrs.emplace_back(bits);
 }
 
 std::string device_to_str(Device device) {
@@ -0,0 +1,57 @@
+#include "utils/thread_pool.h"
+#include "core/common.h"
+#include <utility>
+
+namespace infini {
+
+ThreadPool::ThreadPool(size_t nThreads) : state(std::make_shared<State>()) {
+  IT_ASSERT(nThreads > 0);
+  workers.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    workers.emplace_back(workerLoop, state);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(state->mutex);
+    state->stopping = true;
+  }
+  state->cv.notify_all();
+  for (auto &worker : workers) {
+    // A worker cannot join itself.
+    if (worker.get_id() == std::this_thread::get_id()) {
+      worker.detach();
+    } else {
+      worker.join();
+    }
+  }
+}
+
+void ThreadPool::submit(Task task) {
+  {
+    std::lock_guard lock(state->mutex);
+    IT_ASSERT(!state->stopping, "Submitting to a stopped thread pool");
+    state->tasks.emplace_back(std::move(task));
+  }
+  state->cv.notify_one();
+}
+
+void ThreadPool::workerLoop(const std::shared_ptr<State> &state) {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock lock(state->mutex);
+      state->cv.wait(lock,
+                     [&] { return state->stopping || !state->tasks.empty(); });
+      if (state->tasks.empty()) {
+        return;
+      }
+      task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+    }
+    task();
+  }
+}
+
+} // namespace infini
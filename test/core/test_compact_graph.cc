@@ -0,0 +1,45 @@
+#include "core/compact_graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(CompactGraph, Adjacency) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3}, DataType::Float32);
+  auto relu = g->addOp<ReluObj>(x, nullptr);
+  auto r = relu->getOutput();
+  // Reads `r` twice and `x` once more.
+  auto mul = g->addOp<MulObj>(r, r, nullptr);
+  auto add = g->addOp<AddObj>(mul->getOutput(), x, nullptr);
+
+  CompactGraph cg(*g);
+  ASSERT_EQ(cg.numOperators(), 3);
+  ASSERT_EQ(cg.numTensors(), 4);
+  EXPECT_EQ(cg.getOperator(1), mul);
+  EXPECT_EQ(cg.getOpType(2), OpType::Add);
+  EXPECT_EQ(cg.getTensor(1), r);
+  EXPECT_EQ(cg.getSource(0), CompactGraph::None);
+  EXPECT_EQ(cg.getSource(1), 0);
+  EXPECT_EQ(cg.getBytes(1), 24);
+
+  auto toVec = [](CompactGraph::Row row) {
+    return vector<CompactGraph::Index>(row.begin(), row.end());
+  };
+  using Indices = vector<CompactGraph::Index>;
+  EXPECT_EQ(toVec(cg.getInputs(1)), (Indices{1, 1}));
+  EXPECT_EQ(toVec(cg.getOutputs(2)), (Indices{3}));
+  EXPECT_EQ(toVec(cg.getTargets(0)), (Indices{0, 2}));
+  EXPECT_EQ(toVec(cg.getTargets(1)), (Indices{1}));
+  EXPECT_EQ(toVec(cg.getPredecessors(1)), (Indices{0}));
+  EXPECT_EQ(toVec(cg.getPredecessors(2)), (Indices{1}));
+  EXPECT_EQ(toVec(cg.getSuccessors(0)), (Indices{1}));
+  EXPECT_TRUE(cg.getSuccessors(2).empty());
+  EXPECT_EQ(cg.getOperator(2), add);
+}
+
+} // namespace infini
@@ -1,9 +1,15 @@
 #include "core/graph.h"
 #include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
 #include "operators/matmul.h"
+#include "operators/split.h"
 #include "operators/transpose.h"
+#include "operators/unary.h"
+#include "utils/operator_utils.h"
 
 #include "test.h"
+#include <thread>
 
 namespace infini {
 TEST(Graph, Optimize) {
@@ -34,4 +40,392 @@ TEST(Graph, Optimize) {
   EXPECT_EQ(op->getTransA(), false);
   EXPECT_EQ(op->getTransB(), true);
 }
-} // namespace infini
\ No newline at end of file
+
+TEST(Graph, TransposeChain) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor i = g->addTensor({2, 3, 4}, DataType::Float32);
+  // Three rotations compose to the identity; `t1` has a second consumer.
+  auto t1 = g->addOp<TransposeObj>(i, nullptr, Shape{1, 2, 0})->getOutput();
+  auto t2 = g->addOp<TransposeObj>(t1, nullptr, Shape{1, 2, 0})->getOutput();
+  auto t3 = g->addOp<TransposeObj>(t2, nullptr, Shape{1, 2, 0})->getOutput();
+  auto r1 = g->addOp<ReluObj>(t1, nullptr);
+  auto r3 = g->addOp<ReluObj>(t3, nullptr);
+  // Two mixed permutations merge into one.
+  auto t4 = g->addOp<TransposeObj>(i, nullptr, Shape{1, 0, 2})->getOutput();
+  auto t5 = g->addOp<TransposeObj>(t4, nullptr, Shape{0, 2, 1});
+  g->optimize();
+  EXPECT_TRUE(g->checkValid());
+  EXPECT_EQ(g->getOperators().size(), 4);
+  EXPECT_EQ(r1->getInputs(0), t1);
+  EXPECT_EQ(r3->getInputs(0), i);
+  auto merged = as<TransposeObj>(t5->getOutput()->getSource());
+  EXPECT_EQ(merged->getInputs(0), i);
+  EXPECT_EQ(merged->getPermute(), (vector<int>{1, 2, 0}));
+  EXPECT_EQ(merged->getOutput()->getDims(), (Shape{3, 4, 2}));
+}
+
+TEST(Graph, TopoSort) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3}, DataType::Float32);
+  Tensor y = g->addTensor({2, 3}, DataType::Float32);
+  auto relu = g->addOp<ReluObj>(y, nullptr);
+  // A producer added after its consumer is moved before it by the next sort.
+  auto clip = g->addOpWithOutputs<ClipObj>(x, y, 0.f, 1.f);
+  EXPECT_EQ(g->getOperators(), (OpVec{relu, clip}));
+  EXPECT_TRUE(g->topo_sort());
+  EXPECT_EQ(g->getOperators(), (OpVec{clip, relu}));
+  EXPECT_TRUE(g->findCycle().empty());
+  // A producer replacing an erased one takes its slot right away.
+  g->eraseOperator(clip);
+  clip = g->addOpWithOutputs<ClipObj>(x, y, 0.f, 2.f);
+  EXPECT_EQ(g->getOperators(), (OpVec{clip, relu}));
+
+  g->replaceOpInput(clip, x, relu->getOutput());
+  EXPECT_FALSE(g->topo_sort());
+  EXPECT_EQ(g->findCycle(), (OpVec{clip, relu}));
+  EXPECT_EQ(g->cycleToString(), "Clip[" + std::to_string(clip->getGuid()) +
+                                    "] -> Relu[" +
+                                    std::to_string(relu->getGuid()) + "]");
+}
+
+TEST(Graph, IndexedStorage) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3}, DataType::Float32);
+  OpVec relus;
+  auto t = x;
+  for (int i = 0; i < 1000; ++i) {
+    relus.emplace_back(g->addOp<ReluObj>(t, nullptr));
+    t = relus.back()->getOutput();
+  }
+  EXPECT_EQ(g->getTensor(t->getFuid()), t);
+  EXPECT_EQ(g->getTensor(-1), nullptr);
+
+  // Cut the chain after its first half, from the end.
+  for (auto i = relus.size() - 1; i >= 500; --i) {
+    g->eraseOperator(relus[i]);
+    g->pruneTensor(relus[i]->getOutput());
+  }
+  EXPECT_FALSE(g->hasOperator(relus[500]));
+  EXPECT_TRUE(g->hasOperator(relus[499]));
+  EXPECT_EQ(g->getTensor(t->getFuid()), nullptr);
+  EXPECT_EQ(g->getOperators().size(), 500);
+  EXPECT_EQ(g->getTensors().size(), 501);
+  EXPECT_EQ(g->getOperators().back(), relus[499]);
+  EXPECT_EQ(g->getTensor(relus[499]->getOutput()->getFuid()),
+            relus[499]->getOutput());
+  EXPECT_TRUE(g->checkValid());
+}
+
+TEST(Graph, Schedule) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  // Three branches that each shrink a 4 KiB activation to 64 bytes, built
+  // breadth first so that all activations are live at once.
+  Tensor x = g->addTensor({16, 64}, DataType::Float32);
+  Tensor w = g->addTensor({64, 1}, DataType::Float32);
+  TensorVec activations;
+  TensorVec results;
+  for (int i = 0; i < 3; ++i) {
+    activations.emplace_back(g->addOp<ReluObj>(x, nullptr)->getOutput());
+  }
+  for (const auto &a : activations) {
+    results.emplace_back(g->addOp<MatmulObj>(a, w, nullptr)->getOutput());
+  }
+  g->addOp<ConcatObj>(results, nullptr, 1);
+  auto inputs = 16 * 64 * 4 + 64 * 4;
+  EXPECT_EQ(g->getPeakLiveBytes(), inputs + 3 * 4096 + 64);
+
+  // Each branch finishes before the next one starts.
+  EXPECT_EQ(g->schedule(), inputs + 4096 + 3 * 64);
+  EXPECT_TRUE(g->checkValid());
+  const auto &ops = g->getOperators();
+  for (size_t i = 1; i < ops.size(); ++i) {
+    if (ops[i]->getOpType() == OpType::MatMul) {
+      EXPECT_EQ(ops[i]->getInputs(0)->getSource(), ops[i - 1]);
+    }
+  }
+  EXPECT_EQ(g->schedule(ScheduleObjective::Locality),
+            inputs + 4096 + 3 * 64);
+
+  // Freed activations are reused by the next branch.
+  g->dataMalloc();
+  x->setData(OneGenerator());
+  w->setData(OneGenerator());
+  runtime->run(g);
+  EXPECT_EQ(activations[0]->getRawDataPtr<void *>(),
+            activations[1]->getRawDataPtr<void *>());
+  EXPECT_TRUE(g->getOutputs()[0]->equalData(vector<float>(48, 64)));
+}
+
+namespace {
+// matmul(relu(transpose(x)) + b, w) with x: {2, 3, 4, 5}, b: {5, 1}
+Graph buildSinkable(bool optimize) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3, 4, 5}, DataType::Float32);
+  Tensor b = g->addTensor({5, 1}, DataType::Float32);
+  Tensor w = g->addTensor({2, 3, 4, 6}, DataType::Float32);
+  auto t = g->addOp<TransposeObj>(x, nullptr, Shape{0, 1, 3, 2})->getOutput();
+  auto r = g->addOp<ReluObj>(t, nullptr)->getOutput();
+  auto a = g->addOp<AddObj>(r, b, nullptr)->getOutput();
+  g->addOp<MatmulObj>(a, w, nullptr);
+  if (optimize) {
+    g->optimize();
+  }
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  b->setData(IncrementalGenerator());
+  w->setData(ValGenerator<-1>());
+  runtime->run(g);
+  return g;
+}
+} // namespace
+
+TEST(Graph, TransposeSinking) {
+  auto reference = buildSinkable(false);
+  auto g = buildSinkable(true);
+  EXPECT_TRUE(g->checkValid());
+  // The transpose of x moved down into transA; only b's is left.
+  EXPECT_EQ(g->getOperators().size(), 3);
+  int transposes = 0;
+  for (const auto &op : g->getOperators()) {
+    if (op->getOpType() == OpType::Transpose) {
+      ++transposes;
+      EXPECT_EQ(op->getOutput()->getDims(), (Shape{1, 5}));
+    } else if (op->getOpType() == OpType::MatMul) {
+      EXPECT_TRUE(as<MatmulObj>(op)->getTransA());
+    }
+  }
+  EXPECT_EQ(transposes, 1);
+  EXPECT_TRUE(g->getOutputs()[0]->equalData(reference->getOutputs()[0]));
+}
+
+namespace {
+// matmul(x, transpose(w)) + (b1 + b2) with constant w, b1 and b2
+Graph buildFoldable(bool optimize) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 4}, DataType::Float32);
+  Tensor w = g->addTensor({3, 4}, DataType::Float32);
+  Tensor b1 = g->addTensor({3}, DataType::Float32);
+  Tensor b2 = g->addTensor({3}, DataType::Float32);
+  w->setConstant(IncrementalGenerator());
+  b1->setConstant(IncrementalGenerator());
+  b2->setConstant(ValGenerator<-2>());
+  auto wt = g->addOp<TransposeObj>(w, nullptr, Shape{1, 0})->getOutput();
+  auto b = g->addOp<AddObj>(b1, b2, nullptr)->getOutput();
+  auto y = g->addOp<MatmulObj>(x, wt, nullptr)->getOutput();
+  g->addOp<AddObj>(y, b, nullptr);
+  if (optimize) {
+    g->optimize();
+  }
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  runtime->run(g);
+  return g;
+}
+} // namespace
+
+TEST(Graph, ConstantFolding) {
+  auto reference = buildFoldable(false);
+  auto g = buildFoldable(true);
+  EXPECT_TRUE(g->checkValid());
+  // x, the folded weight and bias, and the output.
+  ASSERT_EQ(g->getOperators().size(), 1);
+  EXPECT_EQ(g->getTensors().size(), 4);
+  auto matmul = as<MatmulObj>(g->getOperators()[0]);
+  EXPECT_FALSE(matmul->getTransB());
+  EXPECT_TRUE(matmul->getInputs(1)->isConstant());
+  EXPECT_EQ(matmul->getInputs(1)->getDims(), (Shape{4, 3}));
+  ASSERT_NE(matmul->getBias(), nullptr);
+  EXPECT_TRUE(matmul->getBias()->isConstant());
+  EXPECT_TRUE(g->getOutputs()[0]->equalData(reference->getOutputs()[0]));
+}
+
+TEST(Graph, CommonSubexpression) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3}, DataType::Float32);
+  Tensor w = g->addTensor({4, 3}, DataType::Float32);
+  auto t1 = g->addOp<TransposeObj>(w, nullptr, Shape{1, 0})->getOutput();
+  auto t2 = g->addOp<TransposeObj>(w, nullptr, Shape{1, 0})->getOutput();
+  auto m1 = g->addOp<MatmulObj>(x, t1, nullptr)->getOutput();
+  auto m2 = g->addOp<MatmulObj>(x, t2, nullptr)->getOutput();
+  auto a = g->addOp<ClipObj>(m1, nullptr, 0.f, 1.f)->getOutput();
+  auto b = g->addOp<ClipObj>(m2, nullptr, 0.f, 1.f)->getOutput();
+  auto c = g->addOp<ClipObj>(m1, nullptr, 0.f, 2.f)->getOutput();
+  auto concat = g->addOp<ConcatObj>(TensorVec{a, b, c}, nullptr, 0);
+  g->optimize();
+  EXPECT_TRUE(g->checkValid());
+  // The transposes merge, fold into the matmuls, which then merge, and so do
+  // the clips with equal bounds.
+  EXPECT_EQ(g->getOperators().size(), 4);
+  EXPECT_EQ(concat->getInputs(0), concat->getInputs(1));
+  EXPECT_NE(concat->getInputs(0), concat->getInputs(2));
+  auto matmul = as<MatmulObj>(concat->getInputs(0)->getSource()->getInputs(0)
+                                  ->getSource());
+  EXPECT_EQ(matmul->getInputs(1), w);
+  EXPECT_TRUE(matmul->getTransB());
+}
+
+TEST(Graph, DeadCodeElimination) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3}, DataType::Float32);
+  Tensor w = g->addTensor({3}, DataType::Float32);
+  auto y = g->addOp<ReluObj>(x, nullptr)->getOutput();
+  // A debug branch and a dead chain reading an otherwise unused weight.
+  g->addOp<ClipObj>(x, nullptr, 0.f, 1.f);
+  auto t = g->addOp<TransposeObj>(x, nullptr, Shape{1, 0})->getOutput();
+  auto a = g->addOp<AddObj>(x, w, nullptr)->getOutput();
+  g->addOp<MulObj>(a, y, nullptr);
+  EXPECT_EQ(g->getOutputs().size(), 3);
+
+  g->markOutput(y);
+  EXPECT_EQ(g->getOutputs(), TensorVec{y});
+  g->optimize();
+  EXPECT_TRUE(g->checkValid());
+  ASSERT_EQ(g->getOperators().size(), 1);
+  EXPECT_EQ(g->getOperators()[0]->getOpType(), OpType::Relu);
+  EXPECT_EQ(g->getTensors(), (TensorVec{x, y}));
+  EXPECT_EQ(t->getSource(), nullptr);
+}
+
+TEST(Graph, CastSimplification) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  {
+    // Int8 -> Int32 -> Float32 -> Transpose -> Int8 is just the Transpose.
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor x = g->addTensor({2, 3}, DataType::Int8);
+    auto t0 = g->addOp<CastObj>(x, nullptr, CastType::Int82Int32)->getOutput();
+    auto t1 =
+        g->addOp<CastObj>(t0, nullptr, CastType::Int322Float)->getOutput();
+    auto t2 = g->addOp<TransposeObj>(t1, nullptr, Shape{1, 0})->getOutput();
+    auto y = g->addOp<CastObj>(t2, nullptr, CastType::Float2Int8)->getOutput();
+    g->optimize();
+    EXPECT_TRUE(g->checkValid());
+    ASSERT_EQ(g->getOperators().size(), 1);
+    EXPECT_EQ(g->getOperators()[0]->getOpType(), OpType::Transpose);
+    EXPECT_EQ(g->getOperators()[0]->getInputs(0), x);
+    EXPECT_EQ(g->getOutputs(), TensorVec{y});
+  }
+  {
+    // Widening casts move below the Concat, where the exact Float16 ->
+    // Float32 -> Float16 round trip cancels.
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor a = g->addTensor({2, 3}, DataType::Float16);
+    Tensor b = g->addTensor({2, 3}, DataType::Float16);
+    auto a1 =
+        g->addOp<CastObj>(a, nullptr, CastType::Float162Float)->getOutput();
+    auto b1 =
+        g->addOp<CastObj>(b, nullptr, CastType::Float162Float)->getOutput();
+    auto c = g->addOp<ConcatObj>(TensorVec{a1, b1}, nullptr, 0)->getOutput();
+    auto h =
+        g->addOp<CastObj>(c, nullptr, CastType::Float2Float16)->getOutput();
+    auto y =
+        g->addOp<CastObj>(h, nullptr, CastType::Float162Float)->getOutput();
+    g->optimize();
+    EXPECT_TRUE(g->checkValid());
+    ASSERT_EQ(g->getOperators().size(), 2);
+    auto concat = g->getOperators()[0];
+    EXPECT_EQ(concat->getOpType(), OpType::Concat);
+    EXPECT_EQ(concat->getInputs(), (TensorVec{a, b}));
+    EXPECT_EQ(concat->getOutput()->getDType(), DataType::Float16);
+    EXPECT_EQ(y->getSource()->getInputs(0), concat->getOutput());
+    EXPECT_EQ(as<CastObj>(y->getSource())->getType(), CastType::Float162Float);
+  }
+  {
+    // Float32 -> Float16 -> Float32 rounds and stays.
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor x = g->addTensor({2, 3}, DataType::Float32);
+    auto h =
+        g->addOp<CastObj>(x, nullptr, CastType::Float2Float16)->getOutput();
+    g->addOp<CastObj>(h, nullptr, CastType::Float162Float);
+    g->optimize();
+    EXPECT_EQ(g->getOperators().size(), 2);
+  }
+}
+
+TEST(Graph, SplitConcat) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  {
+    // Concat(Split(x)) is x.
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor x = g->addTensor({2, 6}, DataType::Float32);
+    auto parts = g->addOp<SplitObj>(x, std::nullopt, 1, 3)->getOutputs();
+    auto c = g->addOp<ConcatObj>(parts, nullptr, 1)->getOutput();
+    g->addOp<ReluObj>(c, nullptr);
+    g->optimize();
+    EXPECT_TRUE(g->checkValid());
+    ASSERT_EQ(g->getOperators().size(), 1);
+    EXPECT_EQ(g->getOperators()[0]->getInputs(0), x);
+  }
+  {
+    // Split(Concat(a, b)) is a, b.
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor a = g->addTensor({1, 3}, DataType::Float32);
+    Tensor b = g->addTensor({2, 3}, DataType::Float32);
+    auto c = g->addOp<ConcatObj>(TensorVec{a, b}, nullptr, 0)->getOutput();
+    auto parts =
+        g->addOp<SplitObj>(c, std::nullopt, 0, vector<int>{1, 2})
+            ->getOutputs();
+    auto ya = g->addOp<ReluObj>(parts[0], nullptr)->getOutput();
+    auto yb = g->addOp<ReluObj>(parts[1], nullptr)->getOutput();
+    g->optimize();
+    EXPECT_TRUE(g->checkValid());
+    ASSERT_EQ(g->getOperators().size(), 2);
+    EXPECT_EQ(ya->getSource()->getInputs(0), a);
+    EXPECT_EQ(yb->getSource()->getInputs(0), b);
+  }
+  {
+    // Joining the parts in another order is no identity.
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor x = g->addTensor({2, 6}, DataType::Float32);
+    auto parts = g->addOp<SplitObj>(x, std::nullopt, 1, 2)->getOutputs();
+    g->addOp<ConcatObj>(TensorVec{parts[1], parts[0]}, nullptr, 1);
+    g->optimize();
+    EXPECT_EQ(g->getOperators().size(), 2);
+  }
+}
+
+TEST(Graph, ConcurrentIds) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  constexpr int numThreads = 4, numTensors = 3000;
+  vector<vector<UidBaseType>> ids(numThreads);
+  vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&, i] {
+      Graph g = make_ref<GraphObj>(runtime);
+      for (int j = 0; j < numTensors; ++j) {
+        ids[i].emplace_back(g->addTensor({1}, DataType::Float32)->getGuid());
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  std::set<UidBaseType> unique;
+  for (const auto &v : ids) {
+    unique.insert(v.begin(), v.end());
+  }
+  EXPECT_EQ(unique.size(), static_cast<size_t>(numThreads * numTensors));
+}
+
+TEST(Graph, LargeTensorSize) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  // 2^33 elements, never allocated.
+  Tensor t = g->addTensor({4, 65536, 32768}, DataType::Float32);
+  EXPECT_EQ(t->size(), size_t{1} << 33);
+  EXPECT_EQ(t->getBytes(), size_t{1} << 35);
+  size_t last = t->size() - 1;
+  auto index = locate_index(last, t->getDims());
+  EXPECT_EQ(index, (Shape{3, 65535, 32767}));
+  Strides strides{int64_t{1} << 31, 32768, 1};
+  EXPECT_EQ(delocate_index(index, t->getDims(), strides), last);
+}
+
+} // namespace infini
@@ -0,0 +1,91 @@
+#include "core/graph.h"
+#include "core/pipeline.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Pipeline, StreamMicroBatches) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 3}, DataType::Float32);
+  auto w = g->addTensor({3}, DataType::Float32);
+  auto t0 = g->addOp<SubObj>(x, w, nullptr)->getOutput();
+  auto t1 = g->addOp<ReluObj>(t0, nullptr)->getOutput();
+  auto t2 = g->addOp<MulObj>(t1, w, nullptr)->getOutput();
+  g->addOp<AddObj>(t2, x, nullptr);
+  g->dataMalloc();
+  w->setData(ValGenerator<2>());
+
+  PipelineExecutor pipeline(g, {3});
+  EXPECT_EQ(pipeline.numStages(), 3);
+  size_t nOps = 0;
+  for (size_t s = 0; s < pipeline.numStages(); ++s) {
+    EXPECT_FALSE(pipeline.getStage(s).empty());
+    nOps += pipeline.getStage(s).size();
+  }
+  EXPECT_EQ(nOps, 4);
+
+  // out = relu(x - 2) * 2 + x, with x filled by the batch index
+  const size_t nBatches = 7;
+  vector<float> results(nBatches, -1);
+  pipeline.run(
+      nBatches,
+      [&](size_t index, const TensorVec &inputs) {
+        for (const auto &t : inputs) {
+          if (t->getFuid() == x->getFuid()) {
+            auto *ptr = t->getRawDataPtr<float *>();
+            std::fill(ptr, ptr + t->size(), static_cast<float>(index));
+          }
+        }
+      },
+      [&](size_t index, const TensorVec &outputs) {
+        ASSERT_EQ(outputs.size(), 1);
+        results[index] = outputs[0]->getRawDataPtr<float *>()[5];
+      });
+  for (size_t i = 0; i < nBatches; ++i) {
+    auto v = static_cast<float>(i);
+    EXPECT_EQ(results[i], std::max(v - 2, 0.f) * 2 + v);
+  }
+}
+
+TEST(Pipeline, ConsumedOutput) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 3}, DataType::Float32);
+  auto y = g->addOp<ReluObj>(x, nullptr)->getOutput();
+  auto z = g->addOp<AddObj>(y, y, nullptr)->getOutput();
+  auto w = g->addOp<AddObj>(z, z, nullptr)->getOutput();
+  auto v = g->addOp<AddObj>(w, w, nullptr)->getOutput();
+  // `y` is an output and is also read by later operators, so its buffer must
+  // not be reused for theirs.
+  g->markOutput(y);
+  g->markOutput(v);
+
+  PipelineExecutor pipeline(g, {2});
+  const size_t nBatches = 3;
+  vector<float> ys(nBatches, -1), vs(nBatches, -1);
+  pipeline.run(
+      nBatches,
+      [&](size_t index, const TensorVec &inputs) {
+        ASSERT_EQ(inputs.size(), 1);
+        auto *ptr = inputs[0]->getRawDataPtr<float *>();
+        std::fill(ptr, ptr + inputs[0]->size(), static_cast<float>(index + 1));
+      },
+      [&](size_t index, const TensorVec &outputs) {
+        ASSERT_EQ(outputs.size(), 2);
+        for (const auto &t : outputs) {
+          auto value = t->getRawDataPtr<float *>()[0];
+          (t->getFuid() == y->getFuid() ? ys : vs)[index] = value;
+        }
+      });
+  for (size_t i = 0; i < nBatches; ++i) {
+    EXPECT_EQ(ys[i], static_cast<float>(i + 1));
+    EXPECT_EQ(vs[i], static_cast<float>(8 * (i + 1)));
+  }
+}
+
+} // namespace infini
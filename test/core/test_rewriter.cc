@@ -0,0 +1,61 @@
+#include "core/graph.h"
+#include "core/rewriter.h"
+#include "core/runtime.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+TEST(Rewriter, FixedPointByPriority) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor x = g->addTensor({2, 3}, DataType::Float32);
+  Tensor value = x;
+  for (int i = 0; i < 4; ++i) {
+    auto op = i % 2 == 0
+                  ? Operator(g->addOp<ClipObj>(value, nullptr, 0.f,
+                                               std::nullopt))
+                  : Operator(g->addOp<ReluObj>(value, nullptr));
+    value = op->getOutput();
+  }
+
+  // Clip(x, 0, inf) -> Relu(x) runs first, then Relu(Relu(x)) -> Relu(x)
+  // collapses the whole chain.
+  RewritePattern clipToRelu{
+      "ClipToRelu", 2, {OpType::Clip}, true,
+      [](GraphObj &graph, const OpVec &ops) {
+        auto clip = as<ClipObj>(ops[0]);
+        if (clip->getMin() != 0.f || clip->getMax()) {
+          return false;
+        }
+        graph.eraseOperator(clip);
+        graph.addOpWithOutputs<ReluObj>(clip->getInputs(0), clip->getOutput());
+        return true;
+      }};
+  RewritePattern mergeRelus{
+      "MergeRelus", 1, {OpType::Relu, OpType::Relu}, true,
+      [](GraphObj &graph, const OpVec &ops) {
+        // Only runs once every Clip is gone.
+        EXPECT_TRUE(std::none_of(
+            graph.getOperators().begin(), graph.getOperators().end(),
+            [](const Operator &op) {
+              return op->getOpType() == OpType::Clip;
+            }));
+        graph.eraseOperator(ops[0]);
+        graph.eraseOperator(ops[1]);
+        graph.pruneTensor(ops[0]->getOutput());
+        graph.addOpWithOutputs<ReluObj>(ops[0]->getInputs(0),
+                                        ops[1]->getOutput());
+        return true;
+      }};
+  PatternRewriter rewriter({mergeRelus, clipToRelu});
+  EXPECT_EQ(rewriter.run(*g), 5);
+  EXPECT_TRUE(g->checkValid());
+  ASSERT_EQ(g->getOperators().size(), 1);
+  auto op = g->getOperators()[0];
+  EXPECT_EQ(op->getOpType(), OpType::Relu);
+  EXPECT_EQ(op->getInputs(0), x);
+  EXPECT_EQ(op->getOutput(), value);
+  EXPECT_EQ(g->getTensors().size(), 2);
+}
+} // namespace infini
@@ -0,0 +1,127 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+
+#include "test.h"
+#include <thread>
+
+namespace infini {
+
+namespace {
+Graph buildAddGraph(Runtime runtime, Tensor &output) {
+  Graph g = make_ref<GraphObj>(runtime);
+  auto t1 = g->addTensor({2, 3}, DataType::Float32);
+  auto t2 = g->addTensor({2, 3}, DataType::Float32);
+  output = g->addOp<AddObj>(t1, t2, nullptr)->getOutput();
+  g->dataMalloc();
+  t1->setData(IncrementalGenerator());
+  t2->setData(OneGenerator());
+  return g;
+}
+} // namespace
+
+TEST(Runtime, RunAsync) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Tensor o1, o2;
+  auto g1 = buildAddGraph(runtime, o1);
+  auto g2 = buildAddGraph(runtime, o2);
+
+  std::atomic<int> callbacks{0};
+  auto f1 = runtime->runAsync(g1, {}, [&](std::exception_ptr error) {
+    EXPECT_EQ(error, nullptr);
+    ++callbacks;
+  });
+  auto f2 = runtime->runAsync(g2);
+  f1.get();
+  f2.get();
+  EXPECT_EQ(callbacks.load(), 1);
+  EXPECT_TRUE(o1->equalData(vector<float>{1, 2, 3, 4, 5, 6}));
+  EXPECT_TRUE(o2->equalData(vector<float>{1, 2, 3, 4, 5, 6}));
+}
+
+TEST(Runtime, SetWorkerThreads) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Tensor o1, o2;
+  auto g1 = buildAddGraph(runtime, o1);
+  auto g2 = buildAddGraph(runtime, o2);
+
+  runtime->setWorkerThreads(2);
+  auto f1 = runtime->runAsync(g1);
+  // The pool is replaced once the queued run has finished.
+  runtime->setWorkerThreads(1);
+  auto f2 = runtime->runAsync(g2);
+  f1.get();
+  f2.get();
+  EXPECT_TRUE(o1->equalData(vector<float>{1, 2, 3, 4, 5, 6}));
+  EXPECT_TRUE(o2->equalData(vector<float>{1, 2, 3, 4, 5, 6}));
+  runtime->setWorkerThreads(0);
+}
+
+TEST(Runtime, SetWorkerThreadsConcurrently) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  const int n = 2000;
+  vector<Graph> graphs;
+  TensorVec outputs(n);
+  for (int i = 0; i < n; ++i) {
+    graphs.emplace_back(buildAddGraph(runtime, outputs[i]));
+  }
+  vector<std::future<void>> futures;
+  std::thread submitter([&] {
+    for (const auto &g : graphs) {
+      futures.emplace_back(runtime->runAsync(g));
+    }
+  });
+  std::thread resizer([&] {
+    for (int i = 0; i < n; ++i) {
+      runtime->setWorkerThreads(i % 3 + 1);
+    }
+  });
+  submitter.join();
+  resizer.join();
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NO_THROW(futures[i].get());
+    EXPECT_TRUE(outputs[i]->equalData(vector<float>{1, 2, 3, 4, 5, 6}));
+  }
+  runtime->setWorkerThreads(0);
+}
+
+TEST(Runtime, ReleasedByItsRun) {
+  std::promise<void> released;
+  std::future<void> done;
+  {
+    Runtime runtime = make_ref<NativeCpuRuntimeObj>();
+    Tensor o;
+    auto g = buildAddGraph(runtime, o);
+    done = runtime->runAsync(
+        g, {}, [f = released.get_future().share()](std::exception_ptr) {
+          f.wait();
+        });
+  }
+  // The run now holds the last reference to the runtime and so destroys its
+  // worker pool from a worker.
+  released.set_value();
+  done.get();
+}
+
+TEST(Runtime, RunAsyncCancelAndDeadline) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Tensor o;
+  auto g = buildAddGraph(runtime, o);
+
+  RunOptions cancelled;
+  cancelled.cancel = make_ref<CancelToken>();
+  cancelled.cancel->cancel();
+  bool failed = false;
+  auto f1 = runtime->runAsync(g, cancelled, [&](std::exception_ptr error) {
+    failed = error != nullptr;
+  });
+  EXPECT_THROW(f1.get(), Exception);
+  EXPECT_TRUE(failed);
+
+  RunOptions expired;
+  expired.deadline = std::chrono::steady_clock::now();
+  EXPECT_THROW(runtime->runAsync(g, expired).get(), Exception);
+  EXPECT_THROW(runtime->run(g, expired), Exception);
+}
+
+} // namespace infini
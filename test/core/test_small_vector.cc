@@ -0,0 +1,50 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "utils/small_vector.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(SmallVector, InlineAndHeap) {
+  SmallVector<int, 4> v{1, 2, 3};
+  const int *inlineData = v.data();
+  v.push_back(4);
+  EXPECT_EQ(v.data(), inlineData);
+  EXPECT_EQ(v.capacity(), 4u);
+  v.push_back(5);
+  EXPECT_GT(v.capacity(), 4u);
+  EXPECT_EQ(vecToString(v), "[1,2,3,4,5]");
+
+  // Moving a heap vector takes its buffer, an inline one is copied.
+  const int *heapData = v.data();
+  SmallVector<int, 4> moved(std::move(v));
+  EXPECT_EQ(moved.data(), heapData);
+  EXPECT_TRUE(v.empty());
+  SmallVector<int, 4> small{7, 8};
+  SmallVector<int, 4> copy(std::move(small));
+  EXPECT_EQ(copy, (SmallVector<int, 4>{7, 8}));
+
+  // Inserting a range of itself.
+  moved.insert(moved.begin() + 1, moved.begin(), moved.end());
+  EXPECT_EQ(vecToString(moved), "[1,1,2,3,4,5,2,3,4,5]");
+  moved.erase(moved.begin() + 1, moved.begin() + 6);
+  EXPECT_EQ(moved, (SmallVector<int, 4>{1, 2, 3, 4, 5}));
+
+  std::vector<int> vec = moved;
+  EXPECT_EQ(vec, (std::vector<int>{1, 2, 3, 4, 5}));
+  EXPECT_EQ((SmallVector<int, 4>(vec)), moved);
+}
+
+TEST(SmallVector, TensorAccessors) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor t = g->addTensor({2, 3, 4}, DataType::Float32);
+  // getDims() hands out the stored shape instead of a copy.
+  EXPECT_EQ(&t->getDims(), &t->getDims());
+  EXPECT_EQ(t->getDims(), (Shape{2, 3, 4}));
+  EXPECT_EQ(t->numTargets(), 0u);
+  EXPECT_FALSE(t->hasSource());
+}
+
+} // namespace infini
@@ -0,0 +1,55 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/fused_element_wise.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+namespace {
+// clip(c - relu(x + b), 1, 4) with x: {2, 3, 4}, b: {4}, c: {3, 1}
+Graph buildChain(Runtime runtime, Tensor &x, Tensor &b, Tensor &c) {
+  Graph g = make_ref<GraphObj>(runtime);
+  x = g->addTensor({2, 3, 4}, DataType::Float32);
+  b = g->addTensor({4}, DataType::Float32);
+  c = g->addTensor({3, 1}, DataType::Float32);
+  auto t0 = g->addOp<AddObj>(x, b, nullptr)->getOutput();
+  auto t1 = g->addOp<ReluObj>(t0, nullptr)->getOutput();
+  auto t2 = g->addOp<SubObj>(c, t1, nullptr)->getOutput();
+  g->addOp<ClipObj>(t2, nullptr, 1.f, 4.f);
+  return g;
+}
+
+// Returns the graph, which owns the memory of the output.
+Graph runChain(bool optimize) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Tensor x, b, c;
+  auto g = buildChain(runtime, x, b, c);
+  if (optimize) {
+    g->optimize();
+    EXPECT_EQ(g->getOperators().size(), 1);
+    EXPECT_EQ(g->getOperators()[0]->getOpType(), OpType::FusedElementWise);
+    EXPECT_EQ(g->getTensors().size(), 4);
+    EXPECT_TRUE(g->checkValid());
+  }
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  b->setData(ValGenerator<-5>());
+  c->setData(IncrementalGenerator());
+  runtime->run(g);
+  return g;
+}
+} // namespace
+
+TEST(FusedElementWise, NativeCpu) {
+  auto reference = runChain(false);
+  auto g = runChain(true);
+  auto expected = reference->getOutputs()[0];
+  auto fused = g->getOutputs()[0];
+  EXPECT_EQ(fused->getDims(), (Shape{2, 3, 4}));
+  EXPECT_TRUE(fused->equalData(expected));
+}
+
+} // namespace infini
@@ -0,0 +1,215 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Matmul, NativeCpu) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, 2, 3}, DataType::Float32);
+    auto b = g->addTensor({3, 2}, DataType::Float32);
+    auto op = g->addOp<MatmulObj>(a, b, nullptr);
+    g->dataMalloc();
+    a->setData(IncrementalGenerator());
+    b->setData(IncrementalGenerator());
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(
+        vector<float>{10, 13, 28, 40, 46, 67, 64, 94}));
+  }
+  {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({3, 2}, DataType::Float32);
+    auto b = g->addTensor({1, 2, 3}, DataType::Float32);
+    auto op = g->addOp<MatmulObj>(a, b, nullptr, true, true);
+    g->dataMalloc();
+    a->setData(IncrementalGenerator());
+    b->setData(IncrementalGenerator());
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(vector<float>{10, 28, 13, 40}));
+  }
+}
+
+TEST(Matmul, PackedConstantB) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  // Columns span two panels of the kernel.
+  const int K = 5, N = 300;
+  for (auto transB : {false, true}) {
+    auto build = [&](bool constant) {
+      Graph g = make_ref<GraphObj>(runtime);
+      auto a = g->addTensor({3, K}, DataType::Float32);
+      auto b = g->addTensor(transB ? Shape{N, K} : Shape{K, N},
+                            DataType::Float32);
+      if (constant) {
+        b->setConstant(IncrementalGenerator());
+      }
+      auto op = g->addOp<MatmulObj>(a, b, nullptr, false, transB);
+      g->dataMalloc();
+      a->setData(IncrementalGenerator());
+      if (!constant) {
+        b->setData(IncrementalGenerator());
+      }
+      return std::make_tuple(g, op, b);
+    };
+    auto [g, op, b] = build(true);
+    auto [ref, refOp, refB] = build(false);
+    // Packed when the graph is allocated.
+    EXPECT_EQ(op->getPackedB().data.size(), K * N * sizeof(float));
+    EXPECT_EQ(op->getPackedB().version, b->getDataVersion());
+    EXPECT_TRUE(refOp->getPackedB().data.empty());
+    runtime->run(g);
+    runtime->run(ref);
+    EXPECT_TRUE(op->getOutput()->equalData(refOp->getOutput()));
+    // Rewriting the weight invalidates the packing.
+    b->setData(OneGenerator());
+    refB->setData(OneGenerator());
+    runtime->run(g);
+    runtime->run(ref);
+    EXPECT_EQ(op->getPackedB().version, b->getDataVersion());
+    EXPECT_TRUE(op->getOutput()->equalData(refOp->getOutput()));
+  }
+}
+
+TEST(Matmul, EpilogueFusion) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  auto build = [&](bool optimize) {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, 2, 3}, DataType::Float32);
+    auto b = g->addTensor({3, 2}, DataType::Float32);
+    auto bias = g->addTensor({2}, DataType::Float32);
+    auto c = g->addOp<MatmulObj>(a, b, nullptr)->getOutput();
+    auto t0 = g->addOp<AddObj>(bias, c, nullptr)->getOutput();
+    auto t1 = g->addOp<ReluObj>(t0, nullptr)->getOutput();
+    g->addOp<ClipObj>(t1, nullptr, std::nullopt, 50.f);
+    if (optimize) {
+      g->optimize();
+      EXPECT_EQ(g->getOperators().size(), 1);
+      auto matmul = as<MatmulObj>(g->getOperators()[0]);
+      EXPECT_EQ(matmul->getBias(), bias);
+      EXPECT_EQ(matmul->getEpilogue().min, 0.f);
+      EXPECT_EQ(matmul->getEpilogue().max, 50.f);
+      EXPECT_TRUE(g->checkValid());
+    }
+    g->dataMalloc();
+    a->setData(IncrementalGenerator());
+    b->setData(IncrementalGenerator());
+    bias->setData(IncrementalGenerator());
+    runtime->run(g);
+    return g;
+  };
+  auto reference = build(false);
+  auto g = build(true);
+  auto expected = vector<float>{10, 14, 28, 41, 46, 50, 50, 50};
+  EXPECT_TRUE(reference->getOutputs()[0]->equalData(expected));
+  EXPECT_TRUE(g->getOutputs()[0]->equalData(expected));
+}
+
+TEST(Matmul, ResidualGemm) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  // 2 * (relu(x) - matmul(a, b)), computed in the buffer of relu(x)
+  auto build = [&](bool optimize) {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, 2, 3}, DataType::Float32);
+    auto b = g->addTensor({3, 2}, DataType::Float32);
+    auto x = g->addTensor({2, 2, 2}, DataType::Float32);
+    auto two = g->addTensor({1}, DataType::Float32);
+    two->setConstant(ValGenerator<2>());
+    auto c = g->addOp<MatmulObj>(a, b, nullptr)->getOutput();
+    auto r = g->addOp<ReluObj>(x, nullptr)->getOutput();
+    auto t = g->addOp<SubObj>(r, c, nullptr)->getOutput();
+    g->addOp<MulObj>(t, two, nullptr);
+    if (optimize) {
+      g->optimize();
+      EXPECT_TRUE(g->checkValid());
+      EXPECT_EQ(g->getOperators().size(), 2);
+      auto matmul = as<MatmulObj>(g->getOutputs()[0]->getSource());
+      EXPECT_EQ(matmul->getBias(), r);
+      EXPECT_EQ(matmul->getEpilogue().alpha, -2.f);
+      EXPECT_EQ(matmul->getEpilogue().beta, 2.f);
+    }
+    g->dataMalloc();
+    if (optimize) {
+      EXPECT_EQ(g->getOutputs()[0]->getRawDataPtr<void *>(),
+                r->getRawDataPtr<void *>());
+    }
+    a->setData(IncrementalGenerator());
+    b->setData(IncrementalGenerator());
+    x->setData(IncrementalGenerator());
+    runtime->run(g);
+    return g;
+  };
+  auto reference = build(false);
+  auto g = build(true);
+  auto expected = vector<float>{-20, -24, -52, -74, -84, -124, -116, -174};
+  EXPECT_TRUE(reference->getOutputs()[0]->equalData(expected));
+  EXPECT_TRUE(g->getOutputs()[0]->equalData(expected));
+}
+
+TEST(Matmul, WideningScale) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto a = g->addTensor({2, 3}, DataType::Float32);
+  auto b = g->addTensor({3, 2}, DataType::Float32);
+  // A scalar of a higher rank widens the output, so it does not fold.
+  auto two = g->addTensor({1, 1, 1}, DataType::Float32);
+  two->setConstant(ValGenerator<2>());
+  auto c = g->addOp<MatmulObj>(a, b, nullptr)->getOutput();
+  auto y = g->addOp<MulObj>(c, two, nullptr)->getOutput();
+  g->optimize();
+  EXPECT_TRUE(g->checkValid());
+  EXPECT_EQ(g->getOperators().size(), 2);
+  EXPECT_EQ(y->getDims(), (Shape{1, 2, 2}));
+  g->dataMalloc();
+  a->setData(IncrementalGenerator());
+  b->setData(IncrementalGenerator());
+  runtime->run(g);
+  EXPECT_TRUE(y->equalData(vector<float>{20, 26, 56, 80}));
+}
+
+TEST(Matmul, MergeSharedInput) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  // Concat(x * w1 + b1, x * w2 + b2) -> x * Concat(w1, w2) + Concat(b1, b2)
+  auto build = [&](bool optimize) {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({2, 4}, DataType::Float32);
+    auto w1 = g->addTensor({4, 3}, DataType::Float32);
+    auto w2 = g->addTensor({4, 5}, DataType::Float32);
+    auto b1 = g->addTensor({3}, DataType::Float32);
+    auto b2 = g->addTensor({5}, DataType::Float32);
+    w1->setConstant(IncrementalGenerator());
+    w2->setConstant(IncrementalGenerator());
+    b1->setConstant(IncrementalGenerator());
+    b2->setConstant(IncrementalGenerator());
+    auto q = g->addOp<MatmulObj>(x, w1, nullptr)->getOutput();
+    auto k = g->addOp<MatmulObj>(x, w2, nullptr)->getOutput();
+    auto q1 = g->addOp<AddObj>(q, b1, nullptr)->getOutput();
+    auto k1 = g->addOp<AddObj>(k, b2, nullptr)->getOutput();
+    g->addOp<ConcatObj>(TensorVec{q1, k1}, nullptr, 1);
+    if (optimize) {
+      g->optimize();
+      EXPECT_TRUE(g->checkValid());
+      EXPECT_EQ(g->getOperators().size(), 1);
+      auto matmul = as<MatmulObj>(g->getOperators()[0]);
+      EXPECT_EQ(matmul->getInputs(0), x);
+      EXPECT_TRUE(matmul->getInputs(1)->isConstant());
+      EXPECT_EQ(matmul->getInputs(1)->getDims(), (Shape{4, 8}));
+      EXPECT_EQ(matmul->getBias()->getDims(), (Shape{8}));
+    }
+    g->dataMalloc();
+    x->setData(IncrementalGenerator());
+    runtime->run(g);
+    return g;
+  };
+  auto reference = build(false);
+  auto g = build(true);
+  EXPECT_EQ(g->getOutputs()[0]->getDims(), (Shape{2, 8}));
+  EXPECT_TRUE(g->getOutputs()[0]->equalData(reference->getOutputs()[0]));
+}
+
+} // namespace infini
@@ -0,0 +1,167 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
+#include "operators/quantize.h"
+
+#include "test.h"
+
+namespace infini {
+
+namespace {
+template <typename T> auto values(vector<T> data) {
+  return [data](void *ptr, size_t size, DataType) {
+    ASSERT_EQ(size, data.size());
+    std::copy(data.begin(), data.end(), static_cast<T *>(ptr));
+  };
+}
+} // namespace
+
+TEST(Quantize, NativeCpu) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 3}, DataType::Float32);
+  auto one = g->addTensor({}, DataType::Float32);
+  auto zero = g->addTensor({}, DataType::Int8);
+  auto q = g->addOp<QuantizeLinearObj>(x, one, zero, nullptr)->getOutput();
+  // Per channel along the columns.
+  auto x2 = g->addTensor({2, 3}, DataType::Float32);
+  auto scales = g->addTensor({3}, DataType::Float32);
+  auto zps = g->addTensor({3}, DataType::UInt8);
+  auto q2 =
+      g->addOp<QuantizeLinearObj>(x2, scales, zps, nullptr)->getOutput();
+  auto y2 = g->addOp<DequantizeLinearObj>(q2, scales, zps, nullptr)
+                ->getOutput();
+  g->dataMalloc();
+  x->setData(values<float>({-1.5, -0.5, 0.5, 1.5, 2.5, 300}));
+  one->setData(values<float>({1}));
+  zero->setData(values<int8_t>({0}));
+  x2->setData(IncrementalGenerator());
+  scales->setData(values<float>({1, 0.5, 2}));
+  zps->setData(values<uint8_t>({0, 10, 0}));
+  runtime->run(g);
+  // Halves round to even, and out of range values saturate.
+  EXPECT_TRUE(q->equalData(vector<int8_t>{-2, 0, 0, 2, 2, 127}));
+  EXPECT_TRUE(q2->equalData(vector<uint8_t>{0, 12, 1, 3, 18, 2}));
+  EXPECT_TRUE(y2->equalData(vector<float>{0, 1, 2, 3, 4, 4}));
+}
+
+TEST(Quantize, Int8Matmul) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  // K is no multiple of 4 and N no multiple of 16, so both are padded.
+  const int M = 3, K = 37, N = 40;
+  vector<int8_t> aData(2 * M * K);
+  vector<int8_t> bData(K * N);
+  for (size_t i = 0; i < aData.size(); ++i) {
+    aData[i] = static_cast<int8_t>(i * 13 % 256 - 128);
+  }
+  for (size_t i = 0; i < bData.size(); ++i) {
+    bData[i] = static_cast<int8_t>(i * 7 % 256 - 128);
+  }
+  vector<int32_t> expected(2 * M * N);
+  for (int batch = 0; batch < 2; ++batch) {
+    for (int i = 0; i < M; ++i) {
+      for (int j = 0; j < N; ++j) {
+        int32_t sum = 0;
+        for (int p = 0; p < K; ++p) {
+          sum += aData[(batch * M + i) * K + p] * bData[p * N + j];
+        }
+        expected[(batch * M + i) * N + j] = sum;
+      }
+    }
+  }
+  vector<int8_t> bTransposed(K * N);
+  for (int p = 0; p < K; ++p) {
+    for (int j = 0; j < N; ++j) {
+      bTransposed[j * K + p] = bData[p * N + j];
+    }
+  }
+  for (auto transB : {false, true}) {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto a = g->addTensor({2, M, K}, DataType::Int8);
+    auto b = g->addTensor(transB ? Shape{N, K} : Shape{K, N}, DataType::Int8);
+    b->setConstant(values(transB ? bTransposed : bData));
+    auto op = g->addOp<MatmulObj>(a, b, nullptr, false, transB);
+    g->dataMalloc();
+    a->setData(values(aData));
+    runtime->run(g);
+    EXPECT_TRUE(op->getOutput()->equalData(expected));
+  }
+}
+
+TEST(Quantize, MatmulPass) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  auto build = [&](bool optimize) {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({4, 8}, DataType::Float32);
+    auto w = g->addTensor({8, 5}, DataType::Float32);
+    auto sx = g->addTensor({}, DataType::Float32);
+    auto zx = g->addTensor({}, DataType::Int8);
+    auto sw = g->addTensor({5}, DataType::Float32);
+    auto zw = g->addTensor({5}, DataType::Int8);
+    w->setConstant(IncrementalGenerator());
+    sx->setConstant(values<float>({0.25}));
+    zx->setConstant();
+    sw->setConstant(values<float>({0.5, 0.4, 0.5, 0.4, 0.5}));
+    zw->setConstant();
+    // Quantization annotations on both operands of a float MatMul.
+    auto xq = g->addOp<QuantizeLinearObj>(x, sx, zx, nullptr)->getOutput();
+    auto xd =
+        g->addOp<DequantizeLinearObj>(xq, sx, zx, nullptr)->getOutput();
+    auto wq =
+        g->addOp<QuantizeLinearObj>(w, sw, zw, nullptr, -1)->getOutput();
+    auto wd =
+        g->addOp<DequantizeLinearObj>(wq, sw, zw, nullptr, -1)->getOutput();
+    auto y = g->addOp<MatmulObj>(xd, wd, nullptr)->getOutput();
+    if (optimize) {
+      g->optimize();
+      EXPECT_TRUE(g->checkValid());
+      const auto &ops = g->getOperators();
+      EXPECT_EQ(ops.size(), 3);
+      if (ops.size() != 3) {
+        return std::make_pair(g, y);
+      }
+      EXPECT_EQ(ops[0]->getOpType(), OpType::QuantizeLinear);
+      EXPECT_EQ(ops[1]->getOpType(), OpType::MatMul);
+      EXPECT_EQ(ops[1]->getDType(), DataType::Int8);
+      EXPECT_TRUE(ops[1]->getInputs(1)->isConstant());
+      EXPECT_EQ(ops[2]->getOpType(), OpType::DequantizeLinear);
+      EXPECT_EQ(ops[2]->getOutput(), y);
+      // Only the Int8 copy of the weight is left.
+      auto tensors = g->getTensors();
+      EXPECT_EQ(std::find(tensors.begin(), tensors.end(), w), tensors.end());
+    }
+    g->dataMalloc();
+    x->setData(IncrementalGenerator());
+    runtime->run(g);
+    return std::make_pair(g, y);
+  };
+  auto [g, y] = build(true);
+  auto [ref, yRef] = build(false);
+  EXPECT_TRUE(y->equalData(yRef, 1e-5));
+}
+
+TEST(Quantize, FoldDequantize) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 3}, DataType::Float32);
+  auto q = g->addTensor({3}, DataType::Int8);
+  auto scale = g->addTensor({}, DataType::Float32);
+  q->setConstant(values<int8_t>({-2, 0, 4}));
+  scale->setConstant(values<float>({0.5}));
+  // A dequantized bias, which no Int8 MatMul takes.
+  auto bias =
+      g->addOp<DequantizeLinearObj>(q, scale, nullptr, nullptr, 0)->getOutput();
+  auto y = g->addOp<AddObj>(x, bias, nullptr)->getOutput();
+  g->optimize();
+  EXPECT_TRUE(g->checkValid());
+  ASSERT_EQ(g->getOperators().size(), 1);
+  EXPECT_EQ(g->getOperators()[0]->getOpType(), OpType::Add);
+  EXPECT_TRUE(bias->isConstant());
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  runtime->run(g);
+  EXPECT_TRUE(y->equalData(vector<float>{-1, 1, 4, 2, 4, 7}));
+}
+
+} // namespace infini
@@ -0,0 +1,61 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/reshape.h"
+#include "operators/transpose.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Reshape, NativeCpu) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({1, 2, 3}, DataType::Float32);
+  auto r = g->addOp<ReluObj>(x, nullptr)->getOutput();
+  auto s = g->addOp<SqueezeObj>(r, nullptr)->getOutput();
+  auto u = g->addOp<UnsqueezeObj>(s, nullptr, vector<int>{0})->getOutput();
+  auto f = g->addOp<FlattenObj>(u, nullptr, 2)->getOutput();
+  auto y = g->addOp<ReshapeObj>(f, nullptr, Shape{3, 2})->getOutput();
+  // The views cost no memory.
+  EXPECT_EQ(g->getPeakLiveBytes(), 2 * x->getBytes());
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  runtime->run(g);
+  for (const auto &t : {s, u, f, y}) {
+    EXPECT_EQ(t->getDataBlob(), r->getDataBlob());
+    EXPECT_TRUE(t->isContiguous());
+  }
+  EXPECT_EQ(y->getDims(), (Shape{3, 2}));
+  EXPECT_TRUE(y->equalData(vector<float>{0, 1, 2, 3, 4, 5}));
+}
+
+TEST(Reshape, StridedInput) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 1, 3}, DataType::Float32);
+  auto w = g->addTensor({2, 2}, DataType::Float32);
+  auto t = g->addOp<TransposeObj>(x, nullptr, vector<int>{1, 2, 0})
+               ->getOutput();
+  // A view of a view, read by a MatMul through its strides.
+  auto s = g->addOp<SqueezeObj>(t, nullptr)->getOutput();
+  auto mm = g->addOp<MatmulObj>(s, w, nullptr)->getOutput();
+  // A Reshape only reads contiguous inputs, so this Transpose copies.
+  auto t2 = g->addOp<TransposeObj>(x, nullptr, vector<int>{1, 2, 0})
+                ->getOutput();
+  auto y = g->addOp<ReshapeObj>(t2, nullptr, Shape{-1})->getOutput();
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  w->setData(IncrementalGenerator());
+  runtime->run(g);
+  EXPECT_EQ(s->getDataBlob(), x->getDataBlob());
+  EXPECT_FALSE(s->isContiguous());
+  EXPECT_NE(t2->getDataBlob(), x->getDataBlob());
+  EXPECT_EQ(y->getDataBlob(), t2->getDataBlob());
+  // s = [[0, 3], [1, 4], [2, 5]]
+  EXPECT_TRUE(mm->equalData(vector<float>{6, 9, 8, 13, 10, 17}));
+  EXPECT_TRUE(y->equalData(vector<float>{0, 3, 1, 4, 2, 5}));
+}
+
+} // namespace infini
@@ -0,0 +1,73 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/concat.h"
+#include "operators/element_wise.h"
+#include "operators/slice.h"
+#include "operators/split.h"
+#include "operators/unary.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Slice, NativeCpu) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({4, 3}, DataType::Float32);
+  auto r = g->addOp<ReluObj>(x, nullptr)->getOutput();
+  // Rows 1 and 2 are a contiguous view, every other element a strided one.
+  auto a = g->addOp<SliceObj>(r, nullptr, vector<int>{1}, vector<int>{3})
+               ->getOutput();
+  auto ya = g->addOp<ReluObj>(a, nullptr)->getOutput();
+  auto b = g->addOp<SliceObj>(r, nullptr, vector<int>{0, 0},
+                              vector<int>{4, 3}, std::nullopt,
+                              vector<int>{2, 2})
+               ->getOutput();
+  auto yb = g->addOp<AddObj>(b, b, nullptr)->getOutput();
+  // A graph output is copied.
+  auto c = g->addOp<SliceObj>(r, nullptr, vector<int>{1}, vector<int>{2},
+                              vector<int>{1})
+               ->getOutput();
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  runtime->run(g);
+  EXPECT_EQ(a->getDataBlob(), r->getDataBlob());
+  EXPECT_TRUE(a->isContiguous());
+  EXPECT_EQ(b->getDataBlob(), r->getDataBlob());
+  EXPECT_FALSE(b->isContiguous());
+  EXPECT_NE(c->getDataBlob(), r->getDataBlob());
+  EXPECT_TRUE(ya->equalData(vector<float>{3, 4, 5, 6, 7, 8}));
+  EXPECT_TRUE(yb->equalData(vector<float>{0, 4, 12, 16}));
+  EXPECT_TRUE(c->equalData(vector<float>{1, 4, 7, 10}));
+}
+
+TEST(Split, NativeCpu) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 4}, DataType::Float32);
+  auto r = g->addOp<ReluObj>(x, nullptr)->getOutput();
+  auto cols = g->addOp<SplitObj>(r, std::nullopt, 1, vector<int>{1, 3})
+                  ->getOutputs();
+  // A strided view read by an Add and a Concat, and a copied graph output.
+  auto y0 = g->addOp<AddObj>(cols[0], cols[0], nullptr)->getOutput();
+  auto c0 = g->addOp<ConcatObj>(TensorVec{cols[0], cols[0]}, nullptr, 1)
+                ->getOutput();
+  auto rows = g->addOp<SplitObj>(r, std::nullopt, 0, 2)->getOutputs();
+  auto c1 = g->addOp<ConcatObj>(TensorVec{rows[1], rows[0]}, nullptr, 0)
+                ->getOutput();
+  g->dataMalloc();
+  x->setData(IncrementalGenerator());
+  runtime->run(g);
+  EXPECT_EQ(cols[0]->getDataBlob(), r->getDataBlob());
+  EXPECT_NE(cols[1]->getDataBlob(), r->getDataBlob());
+  for (const auto &t : rows) {
+    EXPECT_EQ(t->getDataBlob(), r->getDataBlob());
+    EXPECT_TRUE(t->isContiguous());
+  }
+  EXPECT_TRUE(y0->equalData(vector<float>{0, 8}));
+  EXPECT_TRUE(c0->equalData(vector<float>{0, 0, 4, 4}));
+  EXPECT_TRUE(cols[1]->equalData(vector<float>{1, 2, 3, 5, 6, 7}));
+  EXPECT_TRUE(c1->equalData(vector<float>{4, 5, 6, 7, 0, 1, 2, 3}));
+}
+
+} // namespace infini
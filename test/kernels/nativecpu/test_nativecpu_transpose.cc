@@ -1,7 +1,10 @@
 #include "core/graph.h"
 #include "core/runtime.h"
 #include "fmt/base.h"
+#include "operators/element_wise.h"
+#include "operators/matmul.h"
 #include "operators/transpose.h"
+#include "operators/unary.h"
 
 #include "test.h"
 #include "utils/print.hpp"
@@ -31,4 +34,45 @@ TEST(Transpose, NativeCpu) {
                     16, 17, 18, 19, 8,  9,  10, 11, 20, 21, 22, 23}));
 }
 
+TEST(Transpose, View) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  // Relu copies its input, which then has to be materialized.
+  auto build = [&](bool materialize) {
+    Graph g = make_ref<GraphObj>(runtime);
+    auto x = g->addTensor({2, 3, 4}, DataType::Float32);
+    auto w = g->addTensor({3, 5}, DataType::Float32);
+    auto b = g->addTensor({4, 3}, DataType::Float32);
+    auto y = g->addOp<TransposeObj>(x, nullptr, vector<int>{0, 2, 1})
+                 ->getOutput();
+    // A transpose of a view reads it through its strides.
+    auto yy = g->addOp<TransposeObj>(y, nullptr, vector<int>{0, 2, 1})
+                  ->getOutput();
+    auto mm = g->addOp<MatmulObj>(y, w, nullptr)->getOutput();
+    auto mmT = g->addOp<MatmulObj>(w, yy, nullptr, true)->getOutput();
+    auto add = g->addOp<AddObj>(y, b, nullptr)->getOutput();
+    // Nothing reads the graph output z, so it is copied.
+    auto z = g->addOp<TransposeObj>(x, nullptr, vector<int>{2, 1, 0})
+                 ->getOutput();
+    if (materialize) {
+      g->addOp<ReluObj>(y, nullptr);
+    }
+    g->dataMalloc();
+    x->setData(IncrementalGenerator());
+    w->setData(IncrementalGenerator());
+    b->setData(IncrementalGenerator());
+    runtime->run(g);
+    EXPECT_EQ(y->getDataBlob() == x->getDataBlob(), !materialize);
+    EXPECT_EQ(y->isContiguous(), materialize);
+    EXPECT_EQ(yy->getDataBlob(), y->getDataBlob());
+    EXPECT_NE(z->getDataBlob(), x->getDataBlob());
+    return std::make_pair(g, TensorVec{mm, mmT, add, z});
+  };
+  // The graphs own the buffers.
+  auto [g0, views] = build(false);
+  auto [g1, copies] = build(true);
+  for (size_t i = 0; i < views.size(); ++i) {
+    EXPECT_TRUE(views[i]->equalData(copies[i]));
+  }
+}
+
 } // namespace infini
@@ -0,0 +1,47 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/matmul.h"
+#include "operators/quantize.h"
+#include "test.h"
+
+namespace infini {
+TEST(Quantize, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({2, 3}, DataType::Float32);
+  auto scale = g->addTensor({}, DataType::Float32);
+  auto zp = g->addTensor({}, DataType::Int8);
+  auto scales = g->addTensor({3}, DataType::Float32);
+  {
+    auto q = g->addOp<QuantizeLinearObj>(x, scale, zp, nullptr)->getOutput();
+    EXPECT_EQ(q->getDims(), (Shape{2, 3}));
+    EXPECT_EQ(q->getDType(), DataType::Int8);
+    auto y = g->addOp<DequantizeLinearObj>(q, scales, nullptr, nullptr, -1)
+                 ->getOutput();
+    EXPECT_EQ(y->getDType(), DataType::Float32);
+  }
+  {
+    auto op = g->addOp<QuantizeLinearObj>(x, scales, nullptr, nullptr);
+    EXPECT_EQ(op->getOutput()->getDType(), DataType::UInt8);
+    EXPECT_TRUE(op->isPerChannel());
+  }
+  // The scales do not match the dimension they are along.
+  EXPECT_THROW(g->addOp<QuantizeLinearObj>(x, scales, nullptr, nullptr, 0),
+               Exception);
+}
+
+TEST(Quantize, Int8Matmul) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto a = g->addTensor({2, 4, 3}, DataType::Int8);
+  auto b = g->addTensor({3, 5}, DataType::Int8);
+  auto c = g->addOp<MatmulObj>(a, b, nullptr)->getOutput();
+  EXPECT_EQ(c->getDims(), (Shape{2, 4, 5}));
+  EXPECT_EQ(c->getDType(), DataType::Int32);
+  auto bias = g->addTensor({5}, DataType::Int32);
+  EXPECT_THROW(g->addOp<MatmulObj>(a, b, nullptr, false, false, bias),
+               Exception);
+  auto batchedB = g->addTensor({2, 3, 5}, DataType::Int8);
+  EXPECT_THROW(g->addOp<MatmulObj>(a, batchedB, nullptr), Exception);
+}
+} // namespace infini
@@ -0,0 +1,59 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/reshape.h"
+
+#include "test.h"
+
+namespace infini {
+
+TEST(Reshape, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  {
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor i = g->addTensor({2, 3, 4}, DataType::Float32);
+    auto op = g->addOp<ReshapeObj>(i, nullptr, Shape{0, -1});
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{2, 12}));
+  }
+  {
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor i = g->addTensor({2, 3, 4}, DataType::Float32);
+    auto op = g->addOp<ReshapeObj>(i, nullptr, Shape{4, 3, 2});
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{4, 3, 2}));
+  }
+  {
+    Graph g = make_ref<GraphObj>(runtime);
+    Tensor i = g->addTensor({2, 3, 4}, DataType::Float32);
+    EXPECT_THROW(g->addOp<ReshapeObj>(i, nullptr, Shape{5, -1}), Exception);
+  }
+}
+
+TEST(Flatten, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor i = g->addTensor({2, 3, 4, 5}, DataType::Float32);
+  auto op = g->addOp<FlattenObj>(i, nullptr, -2);
+  EXPECT_EQ(op->getOutput()->getDims(), (Shape{6, 20}));
+  op = g->addOp<FlattenObj>(i, nullptr, 0);
+  EXPECT_EQ(op->getOutput()->getDims(), (Shape{1, 120}));
+}
+
+TEST(Squeeze, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor i = g->addTensor({1, 3, 1, 5}, DataType::Float32);
+  auto op = g->addOp<SqueezeObj>(i, nullptr);
+  EXPECT_EQ(op->getOutput()->getDims(), (Shape{3, 5}));
+  op = g->addOp<SqueezeObj>(i, nullptr, vector<int>{-2});
+  EXPECT_EQ(op->getOutput()->getDims(), (Shape{1, 3, 5}));
+  EXPECT_THROW(g->addOp<SqueezeObj>(i, nullptr, vector<int>{1}), Exception);
+}
+
+TEST(Unsqueeze, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  Tensor i = g->addTensor({3, 5}, DataType::Float32);
+  auto op = g->addOp<UnsqueezeObj>(i, nullptr, vector<int>{0, -1});
+  EXPECT_EQ(op->getOutput()->getDims(), (Shape{1, 3, 5, 1}));
+}
+
+} // namespace infini
@@ -0,0 +1,35 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/slice.h"
+#include "test.h"
+
+namespace infini {
+TEST(Slice, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({4, 5, 6}, DataType::Float32);
+  {
+    auto op = g->addOp<SliceObj>(x, nullptr, vector<int>{1, 0},
+                                 vector<int>{3, 5});
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{2, 5, 6}));
+  }
+  {
+    // Negative and out of range indices with steps on chosen axes.
+    auto op = g->addOp<SliceObj>(x, nullptr, vector<int>{-5, 1},
+                                 vector<int>{100, -1}, vector<int>{2, 0},
+                                 vector<int>{2, 2});
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{1, 5, 3}));
+    EXPECT_EQ(op->getStarts(), (vector<int>{1, 0, 1}));
+    EXPECT_EQ(op->getEnds(), (vector<int>{3, 5, 6}));
+    EXPECT_EQ(op->getSteps(), (vector<int>{2, 1, 2}));
+  }
+  {
+    auto op = g->addOp<SliceObj>(x, nullptr, vector<int>{3}, vector<int>{1},
+                                 vector<int>{1});
+    EXPECT_EQ(op->getOutput()->getDims(), (Shape{4, 0, 6}));
+  }
+  EXPECT_THROW(g->addOp<SliceObj>(x, nullptr, vector<int>{0}, vector<int>{1},
+                                  vector<int>{0}, vector<int>{-1}),
+               Exception);
+}
+} // namespace infini
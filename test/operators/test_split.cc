@@ -0,0 +1,28 @@
+#include "core/graph.h"
+#include "core/runtime.h"
+#include "operators/split.h"
+#include "test.h"
+
+namespace infini {
+TEST(Split, ShapeInference) {
+  Runtime runtime = NativeCpuRuntimeObj::getInstance();
+  Graph g = make_ref<GraphObj>(runtime);
+  auto x = g->addTensor({4, 6}, DataType::Float32);
+  {
+    auto op = g->addOp<SplitObj>(x, std::nullopt, -1, 3);
+    ASSERT_EQ(op->getOutputs().size(), 3);
+    for (const auto &t : op->getOutputs()) {
+      EXPECT_EQ(t->getDims(), (Shape{4, 2}));
+    }
+  }
+  {
+    auto op = g->addOp<SplitObj>(x, std::nullopt, 0, vector<int>{1, 3});
+    ASSERT_EQ(op->getOutputs().size(), 2);
+    EXPECT_EQ(op->getOutputs()[0]->getDims(), (Shape{1, 6}));
+    EXPECT_EQ(op->getOutputs()[1]->getDims(), (Shape{3, 6}));
+  }
+  EXPECT_THROW(g->addOp<SplitObj>(x, std::nullopt, 0, 3), Exception);
+  EXPECT_THROW(g->addOp<SplitObj>(x, std::nullopt, 1, vector<int>{2, 2}),
+               Exception);
+}
+} // namespace infini